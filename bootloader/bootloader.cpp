@@ -0,0 +1,102 @@
+/**
+   Serial bootloader for the ATtiny85 @ 8 MHz using avr::uart::soft
+   at 500 kbps. See upload.cpp and README.org.
+
+   The bootloader lives in the last 1 KB of the flash(BOOT_START) and
+   the reset vector of the application is replaced by a jump to it
+   when the page 0 is uploaded. The original reset vector is moved to
+   the last word before the bootloader(the trampoline), which is used
+   to start the application.
+
+   Protocol:
+   1. The host holds a break on Rx while the MCU is reset. Without the
+      break the application is started.
+   2. At the end of the break, the bootloader transmits 'A', 'U',
+      SPM_PAGESIZE and the number of pages of the application.
+   3. The host transmits frames of SPM_PAGESIZE + 3 bytes in a row:
+      the page number, the page and the CRC-16(avr-libc's
+      _crc16_update()) of the previous bytes, LSB first. Each frame is
+      answered with ack after the page is programmed or with nak if
+      the frame is invalid.
+   4. The page number 0xff finishes the upload and starts the
+      application.
+ */
+#include <avr/boot.h>
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <util/crc16.h>
+
+using namespace avr::uart::literals;
+
+#ifndef BOOT_START
+#define BOOT_START 0x1c00
+#endif
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+/** 'rjmp' from the reset vector to the bootloader. The program counter
+ * wraps around on devices with 8 KB of flash. */
+asm(".section .reset_vector,\"ax\",@progbits\n\t"
+    ".word 0xc000 | ((" STR(BOOT_START) " / 2 - 1) & 0xfff)\n\t"
+    ".text");
+
+constexpr uint8_t ack{'K'};
+constexpr uint8_t nak{'N'};
+constexpr uint8_t end_of_upload{0xff};
+constexpr uint8_t app_pages{BOOT_START / SPM_PAGESIZE};
+constexpr uint8_t frame_size{SPM_PAGESIZE + 3};
+
+static void write_page(uint16_t addr, const uint8_t* data) {
+  boot_page_erase(addr);
+  boot_spm_busy_wait();
+  for(uint8_t i{0}; i < SPM_PAGESIZE; i += 2)
+    boot_page_fill(addr + i, data[i] | data[i + 1] << 8);
+  boot_page_write(addr);
+  boot_spm_busy_wait();
+}
+
+/** The bootloader is linked without the startup code, so the zero
+ * register is cleared here and there are no global variables. The
+ * stack pointer is initialized by the hardware. */
+[[gnu::OS_main, gnu::section(".init9")]] int main() {
+  asm volatile("clr __zero_reg__");
+  using namespace avr::io;
+  using tx = Pb4;
+  using rx = Pb3;
+
+  /** pull-up on Rx to read an idle line without a host */
+  rx::high();
+  __builtin_avr_delay_cycles(8);
+
+  if(rx::is_low()) {
+    avr::uart::soft<tx, rx, 500_kbps, 8_MHz> uart;
+    uart.wait_break();
+    uart.put('A');
+    uart.put('U');
+    uart.put(SPM_PAGESIZE);
+    uart.put(app_pages);
+    while(true) {
+      auto frame = uart.get_bytes<frame_size>();
+      uint16_t crc{0xffff};
+      for(uint8_t i{0}; i < frame_size - 2; ++i)
+        crc = _crc16_update(crc, frame[i]);
+      auto page = frame[0];
+      if(crc != (frame[frame_size - 2] | frame[frame_size - 1] << 8)
+         || (page >= app_pages && page != end_of_upload)) {
+        uart.put(nak);
+        continue;
+      }
+      if(page == end_of_upload) {
+        uart.put(ack);
+        break;
+      }
+      write_page(page * SPM_PAGESIZE, frame.data() + 1);
+      uart.put(ack);
+    }
+  }
+  /** leave the pins as they are after a reset */
+  DDRB = 0;
+  PORTB = 0;
+  reinterpret_cast<void(*)()>(BOOT_START / 2 - 1)();
+}
@@ -0,0 +1,184 @@
+/**
+   Host uploader of the serial bootloader. See bootloader.cpp.
+
+   usage: upload <serial device> <application.bin>
+
+   The binary image can be generated by: avr-objcopy -O binary app.elf
+   app.bin
+
+   The break is held on the line during 1 second for each attempt to
+   reach the bootloader, and DTR is pulsed to reset a target that has
+   its reset pin connected to it. Otherwise, the target must be reset
+   manually while the break is held.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+constexpr uint8_t ack{'K'};
+constexpr uint8_t end_of_upload{0xff};
+
+/** The same CRC-16 of avr-libc's _crc16_update() */
+uint16_t crc16(uint16_t crc, uint8_t byte) {
+  crc ^= byte;
+  for(int i{0}; i < 8; ++i)
+    crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  return crc;
+}
+
+[[noreturn]] void fail(const std::string& msg) {
+  std::cerr << msg << std::endl;
+  std::exit(1);
+}
+
+/** Read 1 byte waiting up to 0.5 s. Returns -1 after the timeout. */
+int read_byte(int fd) {
+  uint8_t byte;
+  return read(fd, &byte, 1) == 1 ? byte : -1;
+}
+
+void reset_with_break(int fd) {
+  int dtr{TIOCM_DTR};
+  ioctl(fd, TIOCSBRK);
+  ioctl(fd, TIOCMBIS, &dtr);
+  std::this_thread::sleep_for(10ms);
+  ioctl(fd, TIOCMBIC, &dtr);
+  std::this_thread::sleep_for(1s);
+  tcflush(fd, TCIOFLUSH);
+  ioctl(fd, TIOCCBRK);
+}
+
+/** Write n bytes, resuming after a short write. */
+void write_all(int fd, const uint8_t* bytes, size_t n) {
+  while(n > 0) {
+    auto written = write(fd, bytes, n);
+    if(written <= 0) fail("can't write to the serial device");
+    bytes += written;
+    n -= written;
+  }
+}
+
+/** Send a frame and return true after the ack. When the answer doesn't
+ * come, the bootloader is waiting for bytes that were lost, so single
+ * bytes are sent until it answers, and the frame is sent again. */
+bool send_frame(int fd, const std::vector<uint8_t>& frame) {
+  for(int attempt{0}; attempt < 5; ++attempt) {
+    write_all(fd, frame.data(), frame.size());
+    auto answer = read_byte(fd);
+    for(size_t i{0}; answer == -1 && i < frame.size(); ++i) {
+      uint8_t pad{0};
+      write_all(fd, &pad, 1);
+      answer = read_byte(fd);
+    }
+    if(answer == ack) return true;
+  }
+  return false;
+}
+
+int main(int argc, char** argv) {
+  if(argc != 3) fail("usage: upload <serial device> <application.bin>");
+
+  std::ifstream file(argv[2], std::ios::binary);
+  if(!file) fail(std::string{"can't open "} + argv[2]);
+  std::vector<uint8_t> image{std::istreambuf_iterator<char>(file), {}};
+
+  auto fd = open(argv[1], O_RDWR | O_NOCTTY);
+  if(fd == -1) fail(std::string{"can't open "} + argv[1]);
+
+  struct termios settings{};
+  settings.c_cflag = CREAD | CLOCAL | CS8;
+  settings.c_cc[VMIN] = 0;
+  settings.c_cc[VTIME] = 5;
+  cfsetospeed(&settings, B500000);
+  cfsetispeed(&settings, B500000);
+  tcsetattr(fd, TCSANOW, &settings);
+
+  uint8_t hello[4];
+  bool found{false};
+  for(int attempt{0}; attempt < 10 && !found; ++attempt) {
+    std::cout << "holding a break, reset the target..." << std::endl;
+    reset_with_break(fd);
+    found = true;
+    for(auto& b : hello) {
+      auto byte = read_byte(fd);
+      if(byte == -1) { found = false; break; }
+      b = byte;
+    }
+    found = found && hello[0] == 'A' && hello[1] == 'U';
+  }
+  if(!found) fail("the bootloader didn't answer");
+
+  const size_t page_size{hello[2]}, app_pages{hello[3]};
+  const size_t boot_start{page_size * app_pages};
+  std::printf("page size: %zu bytes, bootloader at %#06zx\n",
+              page_size, boot_start);
+
+  /** The last word before the bootloader is the trampoline to the
+   * application. */
+  if(image.size() > boot_start - 2)
+    fail("the application is larger than "
+         + std::to_string(boot_start - 2) + " bytes");
+  image.resize(boot_start, 0xff);
+
+  /** The reset vector must be a 'rjmp', which is moved to the
+   * trampoline and replaced by a 'rjmp' to the bootloader. The
+   * program counter has 12 bits and it wraps around. */
+  uint16_t reset{uint16_t(image[0] | image[1] << 8)};
+  if((reset & 0xf000) != 0xc000) fail("the reset vector isn't a 'rjmp'");
+  const uint16_t trampoline = boot_start / 2 - 1;
+  const uint16_t target = (1 + reset) & 0xfff;
+  const uint16_t to_app = 0xc000 | ((target - trampoline - 1) & 0xfff);
+  const uint16_t to_boot = 0xc000 | ((boot_start / 2 - 1) & 0xfff);
+  image[boot_start - 2] = to_app;
+  image[boot_start - 1] = to_app >> 8;
+  image[0] = to_boot;
+  image[1] = to_boot >> 8;
+
+  auto make_frame = [&](uint8_t page, const uint8_t* data) {
+    std::vector<uint8_t> frame(page_size + 1);
+    frame[0] = page;
+    std::copy(data, data + page_size, frame.begin() + 1);
+    uint16_t crc{0xffff};
+    for(auto b : frame) crc = crc16(crc, b);
+    frame.push_back(crc);
+    frame.push_back(crc >> 8);
+    return frame;
+  };
+
+  auto begin = std::chrono::steady_clock::now();
+  for(size_t page{0}; page < app_pages; ++page) {
+    auto data = image.data() + page * page_size;
+    bool erased{true};
+    for(size_t i{0}; i < page_size; ++i) erased = erased && data[i] == 0xff;
+    /** The empty pages aren't programmed, except the last one that has
+     * the trampoline. */
+    if(erased) continue;
+    if(!send_frame(fd, make_frame(page, data)))
+      fail("page " + std::to_string(page) + " wasn't programmed");
+    std::cout << '.' << std::flush;
+  }
+  std::vector<uint8_t> empty(page_size, 0xff);
+  if(!send_frame(fd, make_frame(end_of_upload, empty.data())))
+    fail("the bootloader didn't finish the upload");
+
+  std::chrono::duration<double> elapsed{
+    std::chrono::steady_clock::now() - begin};
+  std::printf("\ndone in %.2f s\n", elapsed.count());
+  close(fd);
+}
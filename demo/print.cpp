@@ -0,0 +1,18 @@
+#include <avr/uart.hpp>
+#include <avr/uart/format.hpp>
+
+using namespace avr::io;
+using namespace avr::uart;
+
+int main() {
+  soft<Pb0/*tx*/, Pb1/*rx*/, 9600_bps, 1_MHz> uart;
+  int16_t temperature{215}; //21.5
+  while(true) {
+    auto cmd = uart.get();
+    put_hex(uart, cmd);
+    uart.put(' ');
+    put_fixed<1>(uart, temperature);
+    uart.put('\n');
+    temperature -= cmd;
+  }
+}
@@ -0,0 +1,14 @@
+#include <avr/uart.hpp>
+#include <avr/interrupt.h>
+
+using namespace avr::io;
+using namespace avr::uart::literals;
+
+EMPTY_INTERRUPT(PCINT0_vect);
+
+int main() {
+  avr::uart::soft<Pb0/*tx*/, Pb1/*rx*/, 9600_bps, 1_MHz> uart;
+  while(true)
+    /** Sleep in power-down mode until a byte arrives. */
+    uart.put(uart.sleep_get());
+}
@@ -0,0 +1,17 @@
+#include <avr/uart.hpp>
+
+using namespace avr::io;
+using namespace avr::uart;
+
+int main() {
+  soft<Pb0/*tx*/, Pb1/*rx*/, 19200_bps, 1_MHz> uart;
+  while(true) {
+    /** Sum the bytes of a line without storing them. */
+    uint8_t sum{0};
+    uart.get_stream(consumer<6>([&](uint8_t byte) {
+      sum += byte;
+      return byte != '\n';
+    }));
+    uart.put(sum);
+  }
+}
@@ -0,0 +1,15 @@
+#include <avr/uart.hpp>
+
+using namespace avr::io;
+using namespace avr::uart;
+
+int main() {
+  soft<Pb0/*tx*/, Pb1/*rx*/, 9600_bps, 1200_kHz> uart;
+  /** Transmit a counter while the peer sends its own bytes. */
+  uint8_t cnt{0}, last{0};
+  while(true) {
+    const uint8_t req[]{cnt++, last};
+    auto res = uart.transfer_bytes<2>(req);
+    last = res[0] ^ res[1];
+  }
+}
@@ -0,0 +1,652 @@
+/**
+   Static check of the timing of the bit loops in a listing generated
+   by 'avr-objdump -d' or 'avr-objdump -h -S'(the %.lst outputs of
+   test/Makefile).
+
+   usage: cycle-check <file.lst> [cpu_clock_hz bps] [port pin]
+
+   The clock frequency and the baud rate are taken from the file name
+   when they aren't informed, for example tx_rx_8Mhz_115200bps.lst or
+   tx_rx_1_187Mhz_38400bps.lst. A file name with more baud rates, like
+   bridge_8Mhz_57600bps_1Mbps.lst, has loops at each one of them, and
+   each start passes if its paths pass at one of the rates. The I/O addresses of the Tx port and
+   of the Rx pin register are 0x18 and 0x16(PORTB and PINB of the
+   ATtiny13A/25/45/85) by default. They are written in hexadecimal, so
+   they can also be informed without the clock and the baud rate. An
+   address above 0x3f is reached by 'lds' and 'sts' at the address
+   plus 0x20, like PORTH of the ATmega2560.
+
+   Each transmission starts at an 'in'(or 'lds') from the Tx port and
+   each reception starts at a hunt loop: 'sbic' or 'sbis' on the Rx
+   pin followed by a 'rjmp' to itself(3 cycles), 'lds', 'sbrc' or
+   'sbrs' and a 'rjmp' to the 'lds'(5 cycles), 'in', 'com', 'andi'
+   and a 'breq' to the 'in'(5 cycles, the hunt of select()), or
+   'sbic' or 'sbis' on the Rx pin, a 'rjmp', and 'sbiw' and 'brne'
+   to the first one(6 cycles, a hunt with a timeout like the ones of
+   get_frame() and wait_break()). From
+   each start, the instructions are executed with the cycles of the
+   classic cores, tracking the registers loaded by constants, so the
+   delay loops are walked with their real counts. A branch that
+   depends on a data bit is walked on both paths, and the paths are
+   merged again when they reach the same instruction in the same
+   cycle. A delay loop whose count is only known at run time(the
+   phase of eye_scan()) is walked as a single iteration. The path
+   ends at the next start, at a call, a return or a 'sleep', when it
+   reaches an instruction with the same registers of a previous
+   visit(a loop over an unknown number of bytes), after 256
+   instructions without touching the pins, or, for a reception, at a
+   read that isn't one bit length after the previous one once 8
+   samples are taken(the end of the byte).
+
+   The check fails if:
+   1. two consecutive writes to the Tx port aren't one bit length
+      apart, which means cycles_required for a loop, or the floor or
+      the ceil of the bit length for the unrolled methods, or, for a
+      Manchester burst, the writes at the boundaries and at the
+      middles of the bits aren't one bit length apart;
+   2. the first read of the Rx pin after the start bit isn't around
+      the middle of the start bit or of the first data bit, unless it
+      comes after a delay known only at run time;
+   3. two of the following 8 reads aren't one bit length apart;
+   4. a start has more than 256 paths, which aren't walked.
+
+   Return codes: 0 if the check passes, 1 otherwise.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct insn {
+  uint32_t addr;
+  uint8_t words;
+  string op;
+  vector<string> args;
+  /** absolute target of a relative jump from the objdump comment */
+  int64_t target{-1};
+};
+
+/** -1 means unknown */
+struct state {
+  size_t pc{0};
+  uint64_t t{0};
+  array<int16_t, 32> r;
+  int8_t C{-1}, Z{-1}, N{-1}, T{-1};
+  /** a delay known only at run time was walked */
+  bool variable{false};
+  state() { r.fill(-1); }
+};
+
+struct event {
+  uint64_t t;
+  bool tx;
+  uint32_t addr;
+};
+
+vector<insn> prog;
+map<uint32_t, size_t> index_of;
+uint32_t tx_port{0x18}, rx_pin{0x16};
+double bit;
+unsigned cycles_required;
+unsigned errors{0};
+
+int reg(const string& s) {
+  smatch m;
+  if(regex_match(s, m, regex(R"(r(\d+))"))) return stoi(m[1]);
+  return -1;
+}
+
+long imm(const string& s) { return stol(s, nullptr, 0); }
+
+bool parse(const string& path) {
+  ifstream f(path);
+  if(!f) return false;
+  regex line(R"(^\s*([0-9a-f]+):\t((?:[0-9a-f]{2} )+)\s*\t(\S+)\s*([^;]*)(?:;\s*(0x[0-9a-f]+))?.*$)");
+  string l;
+  while(getline(f, l)) {
+    smatch m;
+    if(!regex_match(l, m, line)) continue;
+    insn i;
+    i.addr = stoul(m[1], nullptr, 16);
+    i.words = count(m[2].first, m[2].second, ' ') / 2;
+    i.op = m[3];
+    string args = m[4];
+    for(size_t b{0}; b < args.size();) {
+      auto e = args.find(',', b);
+      if(e == string::npos) e = args.size();
+      auto a = args.substr(b, e - b);
+      a.erase(0, a.find_first_not_of(" \t"));
+      a.erase(a.find_last_not_of(" \t") + 1);
+      if(!a.empty()) i.args.push_back(a);
+      b = e + 1;
+    }
+    if(m[5].matched) i.target = stoul(m[5], nullptr, 16);
+    index_of[i.addr] = prog.size();
+    prog.push_back(i);
+  }
+  return !prog.empty();
+}
+
+bool is_skip(const insn& i)
+{ return i.op == "sbic" || i.op == "sbis" || i.op == "sbrc"
+    || i.op == "sbrs" || i.op == "cpse"; }
+
+bool reads_rx(const insn& i) {
+  return ((i.op == "sbic" || i.op == "sbis") && imm(i.args[0]) == rx_pin)
+    || (i.op == "in" && imm(i.args[1]) == rx_pin)
+    || (i.op == "lds" && imm(i.args[1]) == rx_pin + 0x20);
+}
+
+bool writes_tx(const insn& i) {
+  return (i.op == "out" && imm(i.args[0]) == tx_port)
+    || ((i.op == "sbi" || i.op == "cbi") && imm(i.args[0]) == tx_port)
+    || (i.op == "sts" && imm(i.args[0]) == tx_port + 0x20);
+}
+
+/** Cycles of the hunt loop at pc, or 0 if there isn't one: 'sbic' or
+    'sbis' on Rx followed by a 'rjmp' to itself, 'lds' from Rx, 'sbrc'
+    or 'sbrs' on the loaded register and a 'rjmp' to the 'lds', or
+    'in' from Rx, 'com', 'andi' and a 'breq' to the 'in'. */
+/** A hunt with a timeout: the 'rjmp' leaves the loop when the line
+    changes, and the counter leaves it at the timeout. */
+bool timed_hunt(size_t pc) {
+  if(pc + 3 >= prog.size()) return false;
+  auto& i = prog[pc];
+  return (i.op == "sbic" || i.op == "sbis") && reads_rx(i)
+    && prog[pc + 1].op == "rjmp" && prog[pc + 2].op == "sbiw"
+    && prog[pc + 3].op == "brne" && prog[pc + 3].target == i.addr;
+}
+
+unsigned hunt_cycles(size_t pc) {
+  if(pc + 1 >= prog.size()) return 0;
+  auto& i = prog[pc];
+  auto& j = prog[pc + 1];
+  if((i.op == "sbic" || i.op == "sbis") && reads_rx(i)
+     && j.op == "rjmp" && j.target == i.addr)
+    return 3;
+  if(pc + 2 >= prog.size()) return 0;
+  auto& k = prog[pc + 2];
+  if(i.op == "lds" && reads_rx(i) && (j.op == "sbrc" || j.op == "sbrs")
+     && j.args[0] == i.args[0] && k.op == "rjmp" && k.target == i.addr)
+    return 5;
+  if(pc + 3 >= prog.size()) return 0;
+  auto& l = prog[pc + 3];
+  if(timed_hunt(pc)) return 6;
+  if(i.op == "in" && reads_rx(i) && j.op == "com" && j.args[0] == i.args[0]
+     && k.op == "andi" && k.args[0] == i.args[0] && l.op == "breq"
+     && l.target == i.addr)
+    return 5;
+  return 0;
+}
+
+bool is_hunt(size_t pc) { return hunt_cycles(pc) > 0; }
+
+bool is_tx_start(size_t pc) {
+  auto& i = prog[pc];
+  return (i.op == "in" && imm(i.args[1]) == tx_port)
+    || (i.op == "lds" && imm(i.args[1]) == tx_port + 0x20);
+}
+
+bool is_end(const insn& i) {
+  static const set<string> ends{"ret", "reti", "call", "rcall", "icall",
+                                "eicall", "ijmp", "eijmp", "jmp", "sleep"};
+  return ends.count(i.op) > 0;
+}
+
+enum class step_t { next, fork };
+
+int16_t get(const state& s, const string& a) {
+  auto n = reg(a);
+  return n < 0 ? -1 : s.r[n];
+}
+
+void set_zn(state& s, int16_t v) {
+  if(v < 0) { s.Z = s.N = -1; return; }
+  s.Z = (v & 0xff) == 0;
+  s.N = (v >> 7) & 1;
+}
+
+/** Execute the instruction at s.pc. A skip or a branch whose
+    condition is unknown returns fork, and 'taken' receives the state
+    after the jump or the skip. */
+step_t step(state& s, state& taken, vector<event>& ev) {
+  auto& i = prog[s.pc];
+  auto& op = i.op;
+  auto d = i.args.empty() ? -1 : reg(i.args[0]);
+  unsigned cyc{1};
+
+  if(writes_tx(i)) ev.push_back({s.t, true, i.addr});
+  if(reads_rx(i)) ev.push_back({s.t, false, i.addr});
+
+  auto next = [&]{ return s.pc + 1; };
+  auto jump = [&](int64_t target) {
+    auto it = index_of.find(target);
+    return it == index_of.end() ? prog.size() : it->second;
+  };
+
+  /** a delay loop whose count is unknown: a single iteration */
+  if(op == "dec" && d >= 0 && s.r[d] < 0 && s.pc + 1 < prog.size()
+     && prog[s.pc + 1].op == "brne" && prog[s.pc + 1].target == i.addr)
+  {
+    s.variable = true;
+    s.r[d] = 0; s.Z = 1; s.N = 0;
+    s.t += 2;
+    s.pc += 2;
+    return step_t::next;
+  }
+
+  if(is_skip(i)) {
+    int8_t cond{-1};
+    if(op == "sbrc" || op == "sbrs") {
+      auto v = get(s, i.args[0]);
+      if(v >= 0) cond = ((v >> imm(i.args[1])) & 1) == (op == "sbrs");
+    } else if(op == "cpse") {
+      auto a = get(s, i.args[0]), b = get(s, i.args[1]);
+      if(a >= 0 && b >= 0) cond = a == b;
+    }
+    auto skip_to = s.pc + 2;
+    auto skip_cycles = 1 + (s.pc + 1 < prog.size() ? prog[s.pc + 1].words : 1);
+    if(cond == 1) { s.t += skip_cycles; s.pc = skip_to; return step_t::next; }
+    if(cond == 0) { s.t += 1; s.pc = next(); return step_t::next; }
+    taken = s;
+    taken.t += skip_cycles;
+    taken.pc = skip_to;
+    s.t += 1;
+    s.pc = next();
+    return step_t::fork;
+  }
+
+  static const map<string, pair<int8_t state::*, bool>> branches{
+    {"brne", {&state::Z, false}}, {"breq", {&state::Z, true}},
+    {"brcs", {&state::C, true}}, {"brlo", {&state::C, true}},
+    {"brcc", {&state::C, false}}, {"brsh", {&state::C, false}},
+    {"brts", {&state::T, true}}, {"brtc", {&state::T, false}},
+    {"brmi", {&state::N, true}}, {"brpl", {&state::N, false}}};
+  auto br = branches.find(op);
+  if(br != branches.end() || op.rfind("br", 0) == 0) {
+    int8_t flag = br == branches.end() ? -1 : s.*(br->second.first);
+    int8_t cond = flag < 0 ? -1 : flag == br->second.second;
+    if(cond == 1) { s.t += 2; s.pc = jump(i.target); return step_t::next; }
+    if(cond == 0) { s.t += 1; s.pc = next(); return step_t::next; }
+    taken = s;
+    taken.t += 2;
+    taken.pc = jump(i.target);
+    s.t += 1;
+    s.pc = next();
+    return step_t::fork;
+  }
+
+  if(op == "rjmp") {
+    s.t += 2;
+    s.pc = jump(i.target);
+    return step_t::next;
+  }
+
+  auto v = d < 0 ? int16_t(-1) : s.r[d];
+  auto src = i.args.size() > 1 ? get(s, i.args[1]) : int16_t(-1);
+  if(op == "ldi" || op == "ser") {
+    s.r[d] = op == "ser" ? 0xff : imm(i.args[1]) & 0xff;
+  } else if(op == "mov") {
+    s.r[d] = src;
+  } else if(op == "clr" || (op == "eor" && i.args[0] == i.args[1])) {
+    s.r[d] = 0; s.Z = 1; s.N = 0;
+  } else if(op == "dec" || op == "inc") {
+    s.r[d] = v < 0 ? -1 : (v + (op == "inc" ? 1 : -1)) & 0xff;
+    set_zn(s, s.r[d]);
+  } else if(op == "subi" || op == "cpi") {
+    auto k = imm(i.args[1]) & 0xff;
+    int16_t res = v < 0 ? -1 : (v - k) & 0xff;
+    s.C = v < 0 ? -1 : v < k;
+    set_zn(s, res);
+    if(op == "subi") s.r[d] = res;
+  } else if(op == "sbiw" || op == "adiw") {
+    auto lo = v, hi = s.r[d + 1];
+    if(lo >= 0 && hi >= 0) {
+      int w = lo | hi << 8, k = imm(i.args[1]);
+      int res = op == "sbiw" ? w - k : w + k;
+      s.C = op == "sbiw" ? w < k : res > 0xffff;
+      res &= 0xffff;
+      s.r[d] = res & 0xff; s.r[d + 1] = res >> 8;
+      s.Z = res == 0; s.N = (res >> 15) & 1;
+    } else {
+      s.r[d] = s.r[d + 1] = -1; s.C = s.Z = s.N = -1;
+    }
+    cyc = 2;
+  } else if(op == "tst" || (op == "and" && i.args[0] == i.args[1])) {
+    set_zn(s, v);
+  } else if(op == "lsr" || op == "ror" || op == "asr") {
+    int16_t res{-1};
+    if(v >= 0 && (op != "ror" || s.C >= 0)) {
+      res = v >> 1;
+      if(op == "ror") res |= s.C << 7;
+      if(op == "asr") res |= v & 0x80;
+    }
+    s.C = v < 0 ? -1 : v & 1;
+    s.r[d] = res;
+    set_zn(s, res);
+  } else if(op == "lsl" || op == "rol" || (op == "add" && i.args[0] == i.args[1])
+            || (op == "adc" && i.args[0] == i.args[1])) {
+    bool with_c = op == "rol" || op == "adc";
+    int16_t res{-1};
+    if(v >= 0 && (!with_c || s.C >= 0))
+      res = ((v << 1) | (with_c ? s.C : 0)) & 0xff;
+    s.C = v < 0 ? -1 : (v >> 7) & 1;
+    s.r[d] = res;
+    set_zn(s, res);
+  } else if(op == "com") {
+    s.r[d] = v < 0 ? -1 : ~v & 0xff;
+    s.C = 1;
+    set_zn(s, s.r[d]);
+  } else if(op == "andi" || op == "cbr" || op == "ori" || op == "sbr") {
+    auto k = imm(i.args[1]) & 0xff;
+    if(v >= 0) {
+      if(op == "andi") s.r[d] = v & k;
+      else if(op == "cbr") s.r[d] = v & ~k;
+      else s.r[d] = v | k;
+    }
+    set_zn(s, s.r[d]);
+  } else if(op == "bst") {
+    s.T = v < 0 ? -1 : (v >> imm(i.args[1])) & 1;
+  } else if(op == "bld") {
+    auto b = imm(i.args[1]);
+    if(v >= 0 && s.T >= 0)
+      s.r[d] = s.T ? v | (1 << b) : v & ~(1 << b);
+    else s.r[d] = -1;
+  } else if(op == "sec" || op == "clc") {
+    s.C = op == "sec";
+  } else if(op == "set" || op == "clt") {
+    s.T = op == "set";
+  } else if(op == "nop" || op == "sei" || op == "cli" || op == "wdr"
+            || op == "out") {
+  } else if(op == "sbi" || op == "cbi" || op == "ld" || op == "st"
+            || op == "ldd" || op == "std" || op == "lds" || op == "sts"
+            || op == "push" || op == "pop" || op == "mul" || op == "movw"
+            || op == "lpm") {
+    cyc = op == "movw" ? 1 : op == "lpm" ? 3 : 2;
+    if(op == "ld" || op == "ldd" || op == "lds" || op == "pop"
+       || op == "lpm")
+      if(d >= 0) s.r[d] = -1;
+    if(op == "movw") { s.r[d] = -1; s.r[d + 1] = -1; }
+    if(op == "mul") { s.r[0] = s.r[1] = -1; s.C = s.Z = -1; }
+  } else {
+    /** any other instruction: the destination and the flags become
+        unknown */
+    if(d >= 0) s.r[d] = -1;
+    s.C = s.Z = s.N = -1;
+  }
+  s.t += cyc;
+  s.pc = next();
+  return step_t::next;
+}
+
+struct report {
+  /** mean cycles from the start bit to its detection */
+  double latency{1.5};
+  size_t paths{0};
+  size_t edges{0}, samples{0};
+  bool incomplete{false};
+  set<string> msgs;
+};
+
+/** The events must be one bit length apart: all of them after
+    cycles_required cycles, or each one less than 1 cycle away from
+    its place in the fractional schedule of the unrolled methods. The
+    writes of a Manchester burst alternate between the boundaries and
+    the middles of the bits, so each write must be cycles_required
+    after the one before the previous. */
+void check_schedule(const vector<const event*>& ev, const char* what,
+                    report& rep)
+{
+  if(ev.size() < 2) return;
+  bool loop{true}, unrolled{true}, manchester{ev.size() > 2};
+  for(size_t k{1}; k < ev.size(); ++k) {
+    loop = loop && ev[k]->t - ev[k - 1]->t == cycles_required;
+    unrolled = unrolled && fabs(ev[k]->t - ev[0]->t - k * bit) < 1;
+    manchester = manchester
+      && (k < 2 || ev[k]->t - ev[k - 2]->t == cycles_required);
+  }
+  if(loop || unrolled || manchester) return;
+  string s{what};
+  char buf[32];
+  for(size_t k{1}; k < ev.size(); ++k) {
+    snprintf(buf, sizeof(buf), " %llu",
+             (unsigned long long)(ev[k]->t - ev[k - 1]->t));
+    s += buf;
+  }
+  snprintf(buf, sizeof(buf), " @%#x", ev[0]->addr);
+  rep.msgs.insert(s + buf);
+}
+
+void check(const vector<event>& ev, uint64_t t0, bool rx, bool variable,
+           report& rep)
+{
+  vector<const event*> tx, rd;
+  for(auto& e : ev) (e.tx ? tx : rd).push_back(&e);
+  rep.edges = max(rep.edges, tx.size());
+  check_schedule(tx, "edge intervals:", rep);
+  if(!rx || rd.empty()) return;
+  /** the start bit fell up to a hunt loop before it was detected */
+  auto first = double(rd[0]->t - t0) + rep.latency;
+  auto tol = max(bit / 4, 2.0);
+  if(!variable && fabs(first - 0.5 * bit) > tol
+     && fabs(first - 1.5 * bit) > tol)
+  {
+    char buf[160];
+    snprintf(buf, sizeof(buf),
+             "first sample %#x: %.1f cycles after the start bit, expected "
+             "%.2f or %.2f", rd[0]->addr, first, 0.5 * bit, 1.5 * bit);
+    rep.msgs.insert(buf);
+  }
+  if(rd.size() > 9) rd.resize(9);
+  rep.samples = max(rep.samples, rd.size());
+  check_schedule(rd, "sample intervals:", rep);
+}
+
+/** The registers and the flags of s at its instruction */
+vector<int32_t> key(const state& s) {
+  vector<int32_t> k(s.r.begin(), s.r.end());
+  k.insert(k.end(), {int32_t(s.pc), s.C, s.Z, s.N, s.T});
+  return k;
+}
+
+/** True if the last event is a read of Rx that isn't one bit length
+    after the previous read, and 8 reads were taken before it. */
+bool after_byte(const vector<event>& ev) {
+  if(ev.empty() || ev.back().tx) return false;
+  size_t reads{0};
+  const event* prev{nullptr};
+  for(size_t k{0}; k + 1 < ev.size(); ++k)
+    if(!ev[k].tx) { ++reads; prev = &ev[k]; }
+  return reads >= 8 && fabs(double(ev.back().t - prev->t) - bit) >= 1;
+}
+
+/** A path being walked */
+struct path {
+  state s;
+  vector<event> ev;
+  set<vector<int32_t>> seen;
+  size_t idle{0};
+};
+
+bool same_events(const vector<event>& a, const vector<event>& b) {
+  return equal(a.begin(), a.end(), b.begin(), b.end(),
+               [](const event& x, const event& y)
+               { return x.t == y.t && x.tx == y.tx && x.addr == y.addr; });
+}
+
+/** The registers and the flags that differ become unknown. */
+void merge(state& a, const state& b) {
+  for(size_t k{0}; k < 32; ++k) if(a.r[k] != b.r[k]) a.r[k] = -1;
+  if(a.C != b.C) a.C = -1;
+  if(a.Z != b.Z) a.Z = -1;
+  if(a.N != b.N) a.N = -1;
+  if(a.T != b.T) a.T = -1;
+  a.variable = a.variable || b.variable;
+}
+
+/** Walk the paths from start in the order of their cycles. Two paths
+    that reach the same instruction in the same cycle after the same
+    events are merged, so a balanced branch doesn't double the
+    paths. The first instruction of a transmission is its start,
+    which doesn't end the path. */
+void walk(const state& start, uint64_t t0, bool rx, report& rep) {
+  multimap<pair<uint64_t, size_t>, path> open;
+  auto push = [&](path p) {
+    auto [b, e] = open.equal_range({p.s.t, p.s.pc});
+    for(auto it = b; it != e; ++it)
+      if(same_events(it->second.ev, p.ev)) {
+        merge(it->second.s, p.s);
+        return;
+      }
+    auto at = make_pair(p.s.t, p.s.pc);
+    open.emplace(at, move(p));
+  };
+  auto end = [&](const path& p) {
+    ++rep.paths;
+    check(p.ev, t0, rx, p.s.variable, rep);
+  };
+  push(path{start});
+  bool first{!rx};
+  while(!open.empty()) {
+    if(rep.paths > 256) { rep.incomplete = true; return; }
+    auto p = move(open.begin()->second);
+    open.erase(open.begin());
+    auto& s = p.s;
+    if(s.pc >= prog.size() || is_end(prog[s.pc]) || p.idle > 256
+       || (!first && (is_hunt(s.pc) || is_tx_start(s.pc)))
+       || !p.seen.insert(key(s)).second)
+    {
+      end(p);
+      continue;
+    }
+    first = false;
+    auto n = p.ev.size();
+    state taken;
+    auto fork = step(s, taken, p.ev) == step_t::fork;
+    if(rx && p.ev.size() > n && after_byte(p.ev)) {
+      p.ev.pop_back();
+      end(p);
+      continue;
+    }
+    p.idle = p.ev.size() == n ? p.idle + 1 : 0;
+    if(fork) {
+      auto q = p;
+      q.s = taken;
+      push(move(q));
+    }
+    push(move(p));
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc != 2 && argc != 4 && argc != 6) {
+    cout << "usage: cycle-check <file.lst> [cpu_clock_hz bps] [port pin]"
+         << endl;
+    return 1;
+  }
+  string path{argv[1]};
+  double clk;
+  vector<double> bauds;
+  auto is_hex = [](const char* a) { return string{a}.rfind("0x", 0) == 0; };
+  if(argc == 4 && is_hex(argv[2]) && is_hex(argv[3])) {
+    tx_port = stoul(argv[2], nullptr, 0);
+    rx_pin = stoul(argv[3], nullptr, 0);
+    argc = 2;
+  }
+  if(argc >= 4) {
+    clk = stod(argv[2]);
+    bauds.push_back(stod(argv[3]));
+  } else {
+    smatch m;
+    regex name(R"((?:^|[_/])(\d+)(?:_(\d+))?M[Hh]z((?:_\d+[kM]?bps)+))");
+    if(!regex_search(path, m, name)) {
+      cout << path << ": clock and baud rate not found in the file name"
+           << endl;
+      return 1;
+    }
+    clk = stod(m[1].str() + (m[2].matched ? "." + m[2].str() : "")) * 1e6;
+    regex rate(R"(_(\d+)(k|M)?bps)");
+    auto rates = m[3].str();
+    for(sregex_iterator it(rates.begin(), rates.end(), rate), end;
+        it != end; ++it)
+    {
+      auto& r = *it;
+      bauds.push_back(stod(r[1]) * (r[2] == "k" ? 1e3 : r[2] == "M" ? 1e6 : 1));
+    }
+  }
+  if(argc == 6) {
+    tx_port = stoul(argv[4], nullptr, 0);
+    rx_pin = stoul(argv[5], nullptr, 0);
+  }
+  if(!parse(path)) {
+    cout << path << ": no instructions" << endl;
+    return 1;
+  }
+
+  for(auto baud : bauds) {
+    bit = clk / baud;
+    cout << path << ": " << bit << " cycles per bit, cycles_required: "
+         << unsigned(bit + 0.5) << endl;
+  }
+  for(size_t pc{0}; pc < prog.size(); ++pc) {
+    auto hunt = hunt_cycles(pc);
+    bool rx = hunt > 0;
+    if(!rx && !is_tx_start(pc)) continue;
+    state s;
+    s.pc = pc;
+    vector<event> ev;
+    if(rx) {
+      /** the start bit is detected by the read of the hunt loop, and
+          the path out of the loop is taken: the skip, or the 'rjmp'
+          of a hunt with a timeout */
+      state taken;
+      while(step(s, taken, ev) != step_t::fork);
+      if(!timed_hunt(pc) && taken.pc != pc) s = taken;
+      ev.clear();
+    }
+    /** the first rate that passes, or the one with less messages */
+    report rep;
+    double baud{0};
+    for(auto b : bauds) {
+      bit = clk / b;
+      cycles_required = unsigned(bit + 0.5);
+      report r;
+      r.latency = hunt / 2.0;
+      walk(s, 0, rx, r);
+      if(!baud || r.msgs.size() + r.incomplete
+         < rep.msgs.size() + rep.incomplete)
+      {
+        rep = r;
+        baud = b;
+      }
+      if(rep.msgs.empty() && !rep.incomplete) break;
+    }
+    if(!rep.edges && !rep.samples) continue;
+    cout << "  " << hex << "0x" << prog[pc].addr << dec
+         << (rx ? " rx" : " tx");
+    if(bauds.size() > 1) cout << " @ " << uint32_t(baud) << " bps";
+    cout << ": " << rep.paths << " path(s), "
+         << (rx ? rep.samples : rep.edges) << (rx ? " samples" : " edges")
+         << (rep.incomplete ? ", incomplete" : "")
+         << (rep.msgs.empty() ? " ok" : "") << endl;
+    size_t shown{0};
+    for(auto& m : rep.msgs) {
+      if(shown++ == 4) {
+        cout << "    ... " << rep.msgs.size() - 4 << " more" << endl;
+        break;
+      }
+      cout << "    " << m << endl;
+    }
+    errors += rep.msgs.size() + rep.incomplete;
+  }
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+/**
+   Host decoder of the streams produced by avr::uart::compressed_tx.
+   See avr/uart/compress.hpp.
+
+   usage: decompress [file]
+
+   The compressed bytes are read from the file or from the standard
+   input, and each sample is printed in a line. Example:
+
+   stty -F /dev/ttyUSB0 9600 raw && decompress /dev/ttyUSB0
+ */
+#include "avr/uart/compress.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+int main(int argc, char** argv) {
+  using namespace std;
+
+  if(argc > 2) {
+    cout << "usage: decompress [file]" << endl;
+    return 1;
+  }
+  auto f = argc == 2 ? fopen(argv[1], "rb") : stdin;
+  if(!f) {
+    cout << "can't open " << argv[1] << endl;
+    return 1;
+  }
+
+  avr::uart::delta_decoder decoder;
+  unsigned long bytes{0}, samples{0};
+  for(int c; (c = fgetc(f)) != EOF; ++bytes) {
+    for(auto n = decoder.push(c); n > 0; --n, ++samples)
+      cout << decoder.value() << '\n';
+  }
+  cout << flush;
+  cerr << bytes << " bytes, " << samples << " samples" << endl;
+}
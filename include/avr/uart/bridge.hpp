@@ -0,0 +1,93 @@
+#pragma once
+
+#include "avr/uart/ring_buffer.hpp"
+#include "avr/uart/soft.hpp"
+
+#include <stdint.h>
+
+namespace avr::uart {
+
+/** statistics collected by bridge::forward() */
+struct bridge_stats {
+  /** bytes received from the source */
+  uint16_t received{0};
+
+  /** bytes dropped because the ring buffer was full */
+  uint16_t overflows{0};
+};
+
+/**
+   Store-and-forward bridge between two avr::uart::soft devices that
+   can use different baud rates.
+
+   The bytes received from Src are stored in a ring buffer, and they
+   are transmitted through Dst in the idle gap that follows the last
+   data bit of each received byte(see soft::get_stream()). When Dst is
+   fast enough to fit at least one frame in that gap, the reception
+   and the transmission overlap and the bridge sustains the throughput
+   of Src. Otherwise, the ring buffer absorbs a burst from Src and it
+   is drained through Dst after the last byte; bytes received while
+   the buffer is full are dropped and counted as overflows.
+
+   Example:
+     bridge<soft<Pb0, Pb1, 57600_bps, 8_MHz>,
+            soft<Pb4, Pb3, 1_Mbps, 8_MHz>> b;
+     b.forward(48);
+     if(b.stats().overflows) { ... }
+
+   Arguments:
+
+   Src: soft device used to receive the bytes.
+
+   Dst: soft device used to transmit the bytes.
+
+   Size: size of the ring buffer, it must be a power of two.
+ */
+template<typename Src, typename Dst, uint8_t Size = 32>
+class bridge {
+  Src _src;
+  Dst _dst;
+  ring_buffer<Size> _ring;
+  bridge_stats _stats;
+
+  /** Estimated cycles to store a received byte and to count it. */
+  static constexpr uint16_t push_cycles{20};
+
+  /** Estimated cycles to transmit a frame through Dst, including the
+      call to put() and the removal of the byte from the ring
+      buffer. */
+  static constexpr uint16_t frame_cycles{10 * Dst::cycles_required + 24};
+
+  static_assert(Src::consumer_cycles_budget >= int16_t(push_cycles),
+    "the bit length of the source is too short to store a received "\
+    "byte before the next start bit.");
+public:
+  /** Number of frames transmitted through Dst in the gap after each
+      byte received from Src. Zero means that Dst is too slow to
+      transmit a frame in the gap. */
+  static constexpr uint8_t frames_per_gap{
+    (Src::consumer_cycles_budget - int16_t(push_cycles)) / frame_cycles};
+
+  /** Receive count bytes from Src and transmit them through Dst. This
+      is a blocking call that returns after the last byte is
+      transmitted. */
+  void forward(uint16_t count) {
+    if(count == 0) return;
+    _src.get_stream(
+      consumer<push_cycles + frames_per_gap * frame_cycles>(
+        [&](uint8_t byte) __attribute__((always_inline)) {
+          ++_stats.received;
+          if(!_ring.push(byte)) ++_stats.overflows;
+          for(uint8_t i{0}; i < frames_per_gap && !_ring.empty(); ++i)
+            _dst.put(_ring.pop());
+          return --count != 0;
+        }));
+    while(!_ring.empty()) _dst.put(_ring.pop());
+  }
+
+  const bridge_stats& stats() const { return _stats; }
+
+  void reset_stats() { _stats = bridge_stats{}; }
+};
+
+}//namespace avr::uart
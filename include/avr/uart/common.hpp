@@ -0,0 +1,123 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace avr::uart {
+
+/**
+   [optional] C++14 user defined literals to describe baud rates and
+   clock frequencies.
+
+   Examples:
+   38400_bps
+   576_Kbps
+   1_Mbps
+
+   1_MHz
+   9600_KHz
+ */
+inline namespace literals {
+  constexpr uint32_t operator""_bps(unsigned long long v) { return v; }
+  constexpr uint32_t operator""_kbps(unsigned long long v) { return v * 1e3; }
+  constexpr uint32_t operator""_Mbps(unsigned long long v) { return v * 1e6; }
+
+  constexpr uint32_t operator""_Hz(unsigned long long v) { return v; }
+  constexpr uint32_t operator""_kHz(unsigned long long v) { return v * 1e3; }
+  constexpr uint32_t operator""_MHz(unsigned long long v) { return v * 1e6; }
+}//namespace literals
+
+/** CPU required cycles to handle transmission or reception of 1 bit. */
+constexpr auto bit_length_cycles(uint32_t clk, uint32_t baud_rate)
+{ return clk * 1.0/baud_rate; }
+
+/** buffer to store N received bytes
+
+    This abstraction is used by get<N>() to return the received
+    bytes.
+ */
+template<uint8_t N>
+class buffer_t {
+  uint8_t _data[N];
+public:
+  static constexpr uint8_t size{N};
+  
+  using iterator = uint8_t*;
+  using const_iterator = const uint8_t*;
+
+  iterator begin() { return _data; }
+  const_iterator begin() const { return _data; }
+  const_iterator cbegin() const { return _data; }
+  iterator end() { return _data + size; }
+  const_iterator end() const { return _data + size; }
+  const_iterator cend() const { return _data + size; }
+  uint8_t& operator[](uint8_t i) { return _data[i]; }
+  const uint8_t& operator[](uint8_t i) const { return _data[i]; }
+  uint8_t* data() { return _data; }
+  const uint8_t* data() const { return _data; }
+};
+
+/** errors flagged by soft::get_checked() */
+namespace rx_error {
+  /** the stop bit was low */
+  constexpr uint8_t framing{0x01};
+
+  /** a start bit was high at its middle and it was ignored */
+  constexpr uint8_t glitch{0x02};
+
+  /** the line was already low at the call, and the byte in progress
+      was dropped */
+  constexpr uint8_t overrun{0x04};
+}
+
+/** byte received by soft::get_checked() and its rx_error flags */
+struct rx_result {
+  uint8_t byte;
+  uint8_t errors;
+};
+
+/** counters of a link updated by soft::get_checked() and
+    soft::get_bytes(link_stats&) */
+struct link_stats {
+  /** received bytes, including the ones with a framing error */
+  uint16_t bytes{0};
+
+  /** bytes with a low stop bit */
+  uint16_t framing_errors{0};
+
+  /** start bits that were high at their middle */
+  uint16_t glitches{0};
+
+  /** start bits that began before the receiver was called */
+  uint16_t overruns{0};
+};
+
+/** 8-bit counter of a timer read by soft::get_timestamped(). Addr is
+    the address of the counter in the I/O space, for example 0x32 for
+    TCNT0 of the ATtiny85. */
+template<uint8_t Addr>
+struct timer_counter {
+  static constexpr uint8_t io_addr() { return Addr; }
+};
+
+/** byte received by soft::get_timestamped() and the value of the
+    timer counter at its start bit */
+struct timestamped {
+  uint8_t byte;
+  uint8_t time;
+};
+
+/** widest window of sampling points, in percent of the bit length,
+    that received a pattern without errors. See soft::eye_scan(). */
+struct eye_window {
+  uint8_t from;
+  uint8_t to;
+
+  /** false if no sampling point received the pattern */
+  bool open;
+
+  /** center of the window, which can be used as the Phase of
+      soft::get() */
+  constexpr uint8_t center() const { return (from + to) / 2; }
+};
+
+}//namespace avr::uart
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+   [optional] Compression of streams of 16-bit samples that vary
+   slowly, like the readings of an ADC, to transmit more samples per
+   second at the same baud rate.
+
+   Each sample is encoded as the difference(delta) from the previous
+   one. The delta is mapped to an unsigned value by zigzag(0, -1, 1,
+   -2, ... -> 0, 1, 2, 3, ...) and transmitted as a varint: 7 bits per
+   byte from the LSB, with the MSB set in all bytes but the last. A
+   delta in -64..63 takes 1 byte, and in -8192..8191 takes 2 bytes.
+   Repeated samples(delta zero) are counted and transmitted as a run:
+   the byte 0x00 followed by the number of repeats(1..255). A varint
+   never starts with 0x00 because the delta zero isn't encoded as a
+   varint.
+
+   The encoder doesn't have a buffer: each byte is transmitted by
+   put() as soon as it's produced, so the few cycles of the encoding
+   are spent between two frames. The decoder takes one byte at a time
+   and it can be used on the host. See helper/decompress.cpp.
+
+   Example:
+     //MCU
+     compressed_tx tx{uart};
+     while(true) {
+       tx.put(read_adc());
+       if(++n == 64) { tx.flush(); n = 0; }
+     }
+
+     //receiver
+     compressed_rx rx{uart};
+     auto sample = rx.get();
+ */
+namespace avr::uart {
+
+namespace detail::compress {
+
+/** byte that starts a run of repeated samples */
+constexpr uint8_t run{0x00};
+
+[[gnu::always_inline]] inline uint16_t zigzag(int16_t v)
+{ return uint16_t(v) << 1 ^ uint16_t(v >> 15); }
+
+[[gnu::always_inline]] inline int16_t unzigzag(uint16_t v)
+{ return int16_t(v >> 1) ^ -int16_t(v & 1); }
+
+}//namespace detail::compress
+
+/** Decoder of the stream. Each byte is given to push(), and the
+    decoded samples are read by value(). */
+class delta_decoder {
+  uint16_t _value{0};
+  uint16_t _acc{0};
+  uint8_t _shift{0};
+  bool _run{false};
+public:
+  /** Decode 1 byte and return the number of samples that end at it:
+      0 if a varint or a run isn't complete, 1 after a varint, or the
+      number of repeats of value() after a run. */
+  uint8_t push(uint8_t byte) {
+    using namespace detail::compress;
+    if(_run) {
+      _run = false;
+      return byte;
+    }
+    if(_shift == 0 && byte == run) {
+      _run = true;
+      return 0;
+    }
+    _acc |= uint16_t(byte & 0x7f) << _shift;
+    if(byte & 0x80) {
+      _shift += 7;
+      return 0;
+    }
+    _value += unzigzag(_acc);
+    _acc = 0;
+    _shift = 0;
+    return 1;
+  }
+
+  /** last decoded sample */
+  uint16_t value() const { return _value; }
+};
+
+/** Encoder that transmits the stream through Uart. */
+template<typename Uart>
+class compressed_tx {
+  const Uart& _uart;
+  uint16_t _prev{0};
+  uint8_t _repeats{0};
+
+  void put_run() {
+    _uart.put(detail::compress::run);
+    _uart.put(_repeats);
+    _repeats = 0;
+  }
+public:
+  explicit compressed_tx(const Uart& uart) : _uart(uart) {}
+
+  /** Encode and transmit a sample. A repeated sample isn't
+      transmitted until the end of its run, see flush(). */
+  void put(uint16_t sample) {
+    int16_t delta = sample - _prev;
+    _prev = sample;
+    if(delta == 0) {
+      if(++_repeats == 255) put_run();
+      return;
+    }
+    if(_repeats) put_run();
+    auto v = detail::compress::zigzag(delta);
+    while(v > 0x7f) {
+      _uart.put(uint8_t(v) | 0x80);
+      v >>= 7;
+    }
+    _uart.put(v);
+  }
+
+  /** Transmit the pending run of repeated samples. It should be
+      called when the stream pauses, otherwise the receiver only sees
+      the repeats after the next change. */
+  void flush() { if(_repeats) put_run(); }
+};
+
+/** Decoder that receives the stream through Uart. */
+template<typename Uart>
+class compressed_rx {
+  const Uart& _uart;
+  delta_decoder _decoder;
+  uint8_t _pending{0};
+public:
+  explicit compressed_rx(const Uart& uart) : _uart(uart) {}
+
+  /** Receive the next sample. This is a blocking call while there
+      isn't a pending repeat. */
+  uint16_t get() {
+    while(!_pending) _pending = _decoder.push(_uart.get());
+    --_pending;
+    return _decoder.value();
+  }
+};
+
+}//namespace avr::uart
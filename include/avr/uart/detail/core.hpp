@@ -0,0 +1,38 @@
+#pragma once
+
+#include <avr/io.h>
+#include <stdint.h>
+
+namespace avr::uart::detail {
+
+/** CPU cycles of the instructions used by the asm templates whose
+    timing depends on the core. The remaining instructions(in, out,
+    sbic, sbis, branches, ALU, ld) take the same cycles on all the
+    supported cores. */
+struct avre_timing {
+  static constexpr uint8_t st{2};
+  static constexpr bool extended_io{true};
+};
+
+/** tinyAVR 0/1/2-series and megaAVR 0-series. The ports are reached
+    in the I/O space through the VPORT registers, see
+    avr::uart::vport_pin. */
+struct avrxt_timing {
+  static constexpr uint8_t st{1};
+  static constexpr bool extended_io{false};
+};
+
+/** Timing of the core selected by the -mmcu option. AVRe and AVRe+
+    share the same timing. The xmega architectures(__AVR_ARCH__ from
+    102 to 107) are shared by the AVRxt and the AVRxm(XMEGA A/B/C/D/E)
+    cores, so the AVRxt is told by its VPORTA register. The AVRxm
+    isn't supported. */
+#if defined(__AVR_XMEGA__) && defined(VPORTA)
+using core_timing = avrxt_timing;
+#elif defined(__AVR_XMEGA__)
+#error "avrUART: the AVRxm core(XMEGA A/B/C/D/E) isn't supported"
+#else
+using core_timing = avre_timing;
+#endif
+
+}//namespace avr::uart::detail
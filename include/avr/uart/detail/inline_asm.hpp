@@ -42,6 +42,140 @@
   "  dec %[bits]                                      \n\t"       \
   "  brne 2b                                          \n\t"
 
+/** put() for a Tx pin in the extended I/O space, where the port is
+    only reachable by 'lds' and 'sts'. The loop takes 9 cycles. */
+#define AVR_UART_PUT_EXT_ASM_TMPL                                       \
+  "  lds  %[port_state], %[portx]                     \n\t"       \
+  "  com  %[byte]                                     \n\t"       \
+  "  ldi  %[bits], 10                                 \n\t"       \
+  "1:cbr  %[port_state], %[mask]                      \n\t"       \
+  "  brcs 2f                                          \n\t"       \
+  "  sbr  %[port_state], %[mask]                      \n\t"       \
+  "2:sts  %[portx], %[port_state]                     \n\t"       \
+  "  lsr  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 1b                                          \n\t"
+
+#define AVR_UART_PUT_EXT_OUT_OPS                        \
+  : [byte] "+r" (byte),                                 \
+    [port_state] "=&d" (port_value),                    \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_PUT_EXT_IN_OPS                                \
+  : [portx] "i" (TxPin::portx::io_addr() + __SFR_OFFSET),      \
+    [mask] "i" (TxPin::bv()),                                  \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** get() for a Rx pin in the extended I/O space. The start bit is
+    hunted in 5 cycles and the loop takes 8 cycles. */
+#define AVR_UART_GET_EXT_ASM_TMPL                                       \
+  "1:lds  %[tmp], %[pinx]                             \n\t"       \
+  "  sbrc %[tmp], %[rx_pin]                           \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "2:ror  %[byte]                                     \n\t"       \
+  "  lds  %[tmp], %[pinx]                             \n\t"       \
+  "  sbrc %[tmp], %[rx_pin]                           \n\t"       \
+  "  sec                                              \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 2b                                          \n\t"
+
+#define AVR_UART_GET_EXT_OUT_OPS                        \
+  : [byte] "+r" (byte),                                 \
+    [bits] "=&d" (bits),                                \
+    [tmp] "=&r" (tmp),                                  \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_GET_EXT_IN_OPS                                \
+  : [pinx] "i" (RxPin::pinx::io_addr() + __SFR_OFFSET),        \
+    [rx_pin] "I" (RxPin::value),                               \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** put() without a loop: each bit is selected by 'bst' and 'bld', so
+    the port is written every 3 cycles plus %[gI] nops, which allows a
+    bit length of 3 cycles. The gaps are computed per bit to follow a
+    fractional bit length. */
+#define AVR_UART_PUT_UNROLLED_BIT(i)                                    \
+  "  bst  %[byte], " #i "                             \n\t"       \
+  "  bld  %[port_state], %[tx_pin]                    \n\t"       \
+  AVR_UART_NOPS("%[g" #i "]")                                     \
+  "  out  %[portx], %[port_state]                     \n\t"
+
+#define AVR_UART_PUT_UNROLLED_ASM_TMPL                                  \
+  "  in   %[port_state], %[portx]                     \n\t"       \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_PUT_UNROLLED_BIT(0)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(1)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(2)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(3)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(4)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(5)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(6)                                    \
+  AVR_UART_PUT_UNROLLED_BIT(7)                                    \
+  "  sbr  %[port_state], %[mask]                      \n\t"       \
+  AVR_UART_NOPS("%[g8]")                                          \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_NOPS("%[g9]")
+
+#define AVR_UART_PUT_UNROLLED_OUT_OPS                   \
+  : [port_state] "=&d" (port_value)
+
+#define AVR_UART_PUT_UNROLLED_IN_OPS                           \
+  : [byte] "r" (byte),                                         \
+    [portx] "I" (TxPin::portx::io_addr()),                     \
+    [mask] "i" (TxPin::bv()),                                  \
+    [tx_pin] "I" (TxPin::value),                               \
+    [g0] "M" (gaps[0]), [g1] "M" (gaps[1]),                    \
+    [g2] "M" (gaps[2]), [g3] "M" (gaps[3]),                    \
+    [g4] "M" (gaps[4]), [g5] "M" (gaps[5]),                    \
+    [g6] "M" (gaps[6]), [g7] "M" (gaps[7]),                    \
+    [g8] "M" (gaps[8]), [g9] "M" (gaps[9])
+
+/** get() without a loop: each bit is sampled by 'sbic' and set by
+    'ori' in 2 cycles plus %[gI] nops. The call returns when the line
+    is high after the last data bit, so the next start bit can't be
+    confused with a low data bit. */
+#define AVR_UART_GET_UNROLLED_BIT(i)                                    \
+  AVR_UART_NOPS("%[g" #i "]")                                     \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  ori  %[byte], 1 << " #i "                        \n\t"
+
+#define AVR_UART_GET_UNROLLED_ASM_TMPL                                  \
+  "  ldi  %[byte], 0                                  \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_GET_UNROLLED_BIT(0)                                    \
+  AVR_UART_GET_UNROLLED_BIT(1)                                    \
+  AVR_UART_GET_UNROLLED_BIT(2)                                    \
+  AVR_UART_GET_UNROLLED_BIT(3)                                    \
+  AVR_UART_GET_UNROLLED_BIT(4)                                    \
+  AVR_UART_GET_UNROLLED_BIT(5)                                    \
+  AVR_UART_GET_UNROLLED_BIT(6)                                    \
+  AVR_UART_GET_UNROLLED_BIT(7)                                    \
+  "2:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 2b                                          \n\t"
+
+#define AVR_UART_GET_UNROLLED_OUT_OPS                   \
+  : [byte] "=&d" (byte)
+
+#define AVR_UART_GET_UNROLLED_IN_OPS                           \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [g0] "M" (gaps[0]), [g1] "M" (gaps[1]),                    \
+    [g2] "M" (gaps[2]), [g3] "M" (gaps[3]),                    \
+    [g4] "M" (gaps[4]), [g5] "M" (gaps[5]),                    \
+    [g6] "M" (gaps[6]), [g7] "M" (gaps[7])
+
 #define AVR_UART_GET_SEQ_ASM_TMPL(_1_5_delay_rest, delay, delay_rest, \
                                   delay_after_fst_bit, delay_after_fst_bit_rest) \
   "  ldi %[cnt], %[n_bytes] \n\t"                                       \
@@ -94,6 +228,1009 @@
   , [n_bytes] "M" (N)                                                   \
   , [one_half_delay_after_fst_bit_b] "M" (one_half_delay_after_fst_bit_b)
 
+#define AVR_UART_SLEEP_GET_ASM_TMPL                                     \
+  "1:sei                                              \n\t"       \
+  "  sleep                                            \n\t"       \
+  "  cli                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "2:ror  %[byte]                                     \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec %[bits]                                      \n\t"       \
+  "  brne 2b                                          \n\t"
+
+#define AVR_UART_SLEEP_GET_OUT_OPS                      \
+  : [byte] "+r" (byte),                                 \
+    [bits] "=d" (bits),                                 \
+    [delay_cnt] "=d" (delay_cnt)
+
+#define AVR_UART_SLEEP_GET_IN_OPS                              \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+#define AVR_UART_SLEEP_GET_SEQ_ASM_TMPL                                 \
+  "  ldi  %[cnt], %[n_bytes]                          \n\t"       \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:dec  %[cnt]                                      \n\t"       \
+  "  breq 4f                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  ".if %[sleep_between] == 0                          \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[busy_delay_b]",               \
+                 "%[busy_delay_rest]")                            \
+  "  rjmp 2b                                          \n\t"       \
+  ".endif                                             \n\t"       \
+  "6:out  %[pcifr], %[pcif]                           \n\t"       \
+  "  sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 7f                                          \n\t"       \
+  "  sei                                              \n\t"       \
+  "  sleep                                            \n\t"       \
+  "  cli                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 6b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  rjmp 2b                                          \n\t"       \
+  "7:                                                 \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[late_delay_b]",               \
+                 "%[late_delay_rest]")                            \
+  "  rjmp 2b                                          \n\t"       \
+  "4:st   %a[values]+, %[byte]                        \n\t"
+
+#define AVR_UART_SLEEP_GET_SEQ_OUT_OPS                  \
+  : [byte] "+r" (byte),                                 \
+    [bits] "=d" (bits),                                 \
+    [delay_cnt] "=d" (delay_cnt),                       \
+    [cnt] "=r" (cnt),                                   \
+    [values] "+e" (pvalues),                            \
+    "=m" (buffer)
+
+#define AVR_UART_SLEEP_GET_SEQ_IN_OPS                          \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [n_bytes] "M" (N),                                         \
+    [pcifr] "I" (AVR_UART_PCIFR_IO_ADDR),                      \
+    [pcif] "r" (uint8_t(AVR_UART_PCIF_BV)),                    \
+    [sleep_between] "M" (sleep_between),                       \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [busy_delay_b] "M" (busy_delay / 3),                       \
+    [busy_delay_rest] "M" (busy_delay % 3),                    \
+    [late_delay_b] "M" (late_delay / 3),                       \
+    [late_delay_rest] "M" (late_delay % 3),                    \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+#define AVR_UART_GET_STREAM_ASM_TMPL                                    \
+  "1:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:ror  %[byte]                                     \n\t"
+
+#define AVR_UART_GET_STREAM_OUT_OPS                     \
+  : [byte] "=r" (byte),                                 \
+    [bits] "=d" (bits),                                 \
+    [delay_cnt] "=d" (delay_cnt)
+
+#define AVR_UART_GET_STREAM_IN_OPS                             \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Receive %[n] bytes and read the timer counter %[counter] 2 cycles
+    after the sample of the hunt loop that sees each start bit. The
+    line is waited to be high before hunting a start bit, and the byte
+    and its time are stored in a row. The loop takes 8 cycles. */
+#define AVR_UART_GET_TIMESTAMPED_ASM_TMPL                               \
+  "4:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 4b                                          \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "  in   %[time], %[counter]                         \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:ror  %[byte]                                     \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  st   %a[values]+, %[time]                        \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  brne 4b                                          \n\t"
+
+#define AVR_UART_GET_TIMESTAMPED_OUT_OPS                \
+  : [byte] "=&r" (byte),                                \
+    [time] "=&r" (time),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [n] "+r" (n),                                       \
+    [values] "+e" (values),                             \
+    "=m" (*values)
+
+#define AVR_UART_GET_TIMESTAMPED_IN_OPS                        \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [counter] "I" (Counter::io_addr()),                        \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Receive 1 byte after the Rx line stays idle during %[iterations]
+    iterations of 6 cycles, and read the first data bit 3 * %[first]
+    + 4 cycles after the start bit. %[first] is a register, so the
+    sampling point can be changed at runtime. The loop takes 8
+    cycles. */
+#define AVR_UART_GET_PHASE_ASM_TMPL                                     \
+  "0:ldi  %A[cnt], lo8(%[iterations])                 \n\t"       \
+  "  ldi  %B[cnt], hi8(%[iterations])                 \n\t"       \
+  "4:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 0b                                          \n\t"       \
+  "  sbiw %[cnt], 1                                   \n\t"       \
+  "  brne 4b                                          \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "  mov  %[delay_cnt], %[first]                      \n\t"       \
+  "3:dec  %[delay_cnt]                                \n\t"       \
+  "  brne 3b                                          \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:ror  %[byte]                                     \n\t"
+
+#define AVR_UART_GET_PHASE_OUT_OPS                      \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [cnt] "=&w" (cnt)
+
+#define AVR_UART_GET_PHASE_IN_OPS                              \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [iterations] "i" (iterations),                             \
+    [first] "r" (first),                                       \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** put() of avr::uart::ir. The Tx pin toggles %[halfs] times each
+    %[half] cycles during a bit that is 0, which drives a carrier
+    burst, and it stays low during a bit that is 1. The start bit
+    comes from the carry and the stop bit from the zero shifted into
+    the complemented byte. A half period takes 5 cycles of
+    instructions and a bit takes 7 cycles besides the half periods
+    and the padding. */
+#define AVR_UART_IR_PUT_ASM_TMPL                                        \
+  "  in   %[port_state], %[portx]                     \n\t"       \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "  com  %[byte]                                     \n\t"       \
+  "  ldi  %[bits], 10                                 \n\t"       \
+  "  sec                                              \n\t"       \
+  "1:clr  %[toggle]                                   \n\t"       \
+  "  brcc 2f                                          \n\t"       \
+  "  ldi  %[toggle], %[mask]                          \n\t"       \
+  "2:ldi  %[halfs], %[n_halfs]                        \n\t"       \
+  "4:eor  %[port_state], %[toggle]                    \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[half_b]", "%[half_rest]")     \
+  "  dec  %[halfs]                                    \n\t"       \
+  "  brne 4b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[pad_b]", "%[pad_rest]")       \
+  "  lsr  %[byte]                                     \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 1b                                          \n\t"
+
+#define AVR_UART_IR_PUT_OUT_OPS                         \
+  : [byte] "+r" (byte),                                 \
+    [port_state] "=&d" (port_state),                    \
+    [toggle] "=&d" (toggle),                            \
+    [bits] "=&d" (bits),                                \
+    [halfs] "=&d" (halfs),                              \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_IR_PUT_IN_OPS                                 \
+  : [portx] "I" (TxPin::portx::io_addr()),                     \
+    [mask] "M" (TxPin::bv()),                                  \
+    [n_halfs] "M" (halfs_per_bit),                             \
+    [half_b] "M" (half_delay / 3),                             \
+    [half_rest] "M" (half_delay % 3),                          \
+    [pad_b] "M" (pad / 3),                                     \
+    [pad_rest] "M" (pad % 3)
+
+/** get() of avr::uart::ir with 16-bit delays, which allows the long
+    bit lengths of the IR links. The loop takes 8 cycles. */
+#define AVR_UART_IR_GET_ASM_TMPL                                        \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY16("cnt", "%[first_b]", "%[first_rest]")          \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY16("cnt", "%[delay_b]", "%[delay_rest]")          \
+  "  rjmp 2b                                          \n\t"       \
+  "5:ror  %[byte]                                     \n\t"
+
+#define AVR_UART_IR_GET_OUT_OPS                         \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [cnt] "=&w" (cnt)
+
+#define AVR_UART_IR_GET_IN_OPS                                 \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [first_b] "i" (delay16_b(first)),                          \
+    [first_rest] "M" (delay16_rest(first)),                    \
+    [delay_b] "i" (delay16_b(delay)),                          \
+    [delay_rest] "M" (delay16_rest(delay))
+
+/** put_manchester(): a start bit 0 and %[n] bytes from the LSB as
+    Manchester symbols. Each bit has the complement of its value in
+    the first half and its value in the second half, so there is a
+    transition at the middle of each bit. The first half of the start
+    bit is the idle line. Both paths at the end of a bit take 8 cycles,
+    so the bits at the boundaries of the bytes have the same length. */
+#define AVR_UART_MANCHESTER_PUT_ASM_TMPL                                \
+  "  in   %[port_state], %[portx]                     \n\t"       \
+  "  ld   %[byte], %a[values]+                        \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[start_b]", "%[start_rest]")   \
+  "2:sbr  %[port_state], %[mask]                      \n\t"       \
+  "  sbrc %[byte], 0                                  \n\t"       \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[first_b]", "%[first_rest]")   \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "  sbrc %[byte], 0                                  \n\t"       \
+  "  sbr  %[port_state], %[mask]                      \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"       \
+  "  lsr  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[second_b]", "%[second_rest]") \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 4f                                          \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ld   %[byte], %a[values]+                        \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "  rjmp 2b                                          \n\t"       \
+  "4:rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp 2b                                          \n\t"       \
+  "5:rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  sbr  %[port_state], %[mask]                      \n\t"       \
+  "  out  %[portx], %[port_state]                     \n\t"
+
+#define AVR_UART_MANCHESTER_PUT_OUT_OPS                 \
+  : [values] "+e" (bytes),                              \
+    [n] "+r" (n),                                       \
+    [byte] "=&r" (byte),                                \
+    [port_state] "=&d" (port_state),                    \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_MANCHESTER_PUT_IN_OPS                         \
+  : [portx] "I" (Uart::tx_pin::portx::io_addr()),              \
+    [mask] "M" (Uart::tx_pin::bv()),                           \
+    [start_b] "M" (start / 3),                                 \
+    [start_rest] "M" (start % 3),                              \
+    [first_b] "M" (first / 3),                                 \
+    [first_rest] "M" (first % 3),                              \
+    [second_b] "M" (second / 3),                               \
+    [second_rest] "M" (second % 3)
+
+/** get_manchester(): the edge at the middle of the start bit is
+    hunted, and each bit is sampled in its first half at %[delay]
+    cycles after the edge at the middle of the previous bit, which is
+    the complement of the bit. The loop waits for the edge at the
+    middle of the bit that was sampled and starts again from it, so
+    the phase is locked once per bit. Both waits and the hunt take 3
+    cycles per test and 4 cycles from the edge to the delay. */
+#define AVR_UART_MANCHESTER_GET_ASM_TMPL                                \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "  rjmp 2f                                          \n\t"       \
+  "2:                                                 \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 4f                                          \n\t"       \
+  "  lsr  %[byte]                                     \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 5f                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  breq 7f                                          \n\t"       \
+  "5:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 5b                                          \n\t"       \
+  "  rjmp 2b                                          \n\t"       \
+  "4:sec                                              \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 6f                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  breq 7f                                          \n\t"       \
+  "6:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 6b                                          \n\t"       \
+  "  rjmp 2b                                          \n\t"       \
+  "7:                                                 \n\t"
+
+#define AVR_UART_MANCHESTER_GET_OUT_OPS                 \
+  : [values] "+e" (bytes),                              \
+    [n] "+r" (n),                                       \
+    [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_MANCHESTER_GET_IN_OPS                         \
+  : [pinx] "I" (Uart::rx_pin::pinx::io_addr()),                \
+    [rx_pin] "I" (Uart::rx_pin::value),                        \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Cut-through loop used by repeat(). The start bit is checked and
+    driven on Tx at its middle, and each data bit is driven 4 cycles
+    after its sample. %[borrow] has the Rx bit set to decrement the
+    byte while it is repeated: the output bit is the input bit xor
+    the borrow, and the borrow is cleared by the first 1. */
+#define AVR_UART_REPEAT_ASM_TMPL                                        \
+  "  in   %[port], %[portx]                           \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[half_delay_b]",               \
+                 "%[half_delay_rest]")                            \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "  cbr  %[port], %[mask]                            \n\t"       \
+  "  nop                                              \n\t"       \
+  "  out  %[portx], %[port]                           \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[fst_delay_b]",                \
+                 "%[fst_delay_rest]")                             \
+  "2:in   %[tmp], %[pinx]                             \n\t"       \
+  "  eor  %[tmp], %[borrow]                           \n\t"       \
+  "  bst  %[tmp], %[rx_pin]                           \n\t"       \
+  "  bld  %[port], %[tx_pin]                          \n\t"       \
+  "  out  %[portx], %[port]                           \n\t"       \
+  "  eor  %[tmp], %[borrow]                           \n\t"       \
+  "  bst  %[tmp], %[rx_pin]                           \n\t"       \
+  "  lsr  %[byte]                                     \n\t"       \
+  "  bld  %[byte], 7                                  \n\t"       \
+  "  sbrc %[byte], 7                                  \n\t"       \
+  "  clr  %[borrow]                                   \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 2b                                          \n\t"       \
+  "  sbr  %[port], %[mask]                            \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  out  %[portx], %[port]                           \n\t"
+
+#define AVR_UART_REPEAT_OUT_OPS                         \
+  : [byte] "=&r" (byte),                                \
+    [port] "=&d" (port_value),                          \
+    [bits] "=&d" (bits),                                \
+    [tmp] "=&r" (tmp),                                  \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [borrow] "+r" (borrow)
+
+#define AVR_UART_REPEAT_IN_OPS                                 \
+  : [portx] "I" (TxPin::portx::io_addr()),                     \
+    [mask] "i" (TxPin::bv()),                                  \
+    [tx_pin] "I" (TxPin::value),                               \
+    [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [half_delay_b] "M" (half_delay / 3),                       \
+    [half_delay_rest] "M" (half_delay % 3),                    \
+    [fst_delay_b] "M" (fst_delay / 3),                         \
+    [fst_delay_rest] "M" (fst_delay % 3),                      \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Transmit the 11 bits of %[frame] from the LSB: the start bit, 8
+    data bits, the address bit and the stop bit. The loop takes 9
+    cycles. */
+#define AVR_UART_PUT9_ASM_TMPL                                          \
+  "  in   %[port_state], %[portx]                     \n\t"       \
+  "  ldi  %[bits], 11                                 \n\t"       \
+  "1:sbr  %[port_state], %[mask]                      \n\t"       \
+  "  lsr  %B[frame]                                   \n\t"       \
+  "  ror  %A[frame]                                   \n\t"       \
+  "  brcs 2f                                          \n\t"       \
+  "  cbr  %[port_state], %[mask]                      \n\t"       \
+  "2:out  %[portx], %[port_state]                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 1b                                          \n\t"
+
+#define AVR_UART_PUT9_OUT_OPS                           \
+  : [frame] "+r" (frame),                               \
+    [port_state] "=&d" (port_value),                    \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_PUT9_IN_OPS                                   \
+  : [portx] "I" (TxPin::portx::io_addr()),                     \
+    [mask] "i" (TxPin::bv()),                                  \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Receive frames of 9 data bits and store the %[n] data bytes that
+    follow an address byte equal to %[address]. The 9th bit is set in
+    an address byte. The line is waited to be high after the 9th bit
+    before hunting the next start bit. The frames of the other nodes
+    are sampled but not stored. When %[sleep] is 1, the start bits
+    are waited in the sleep mode while the node isn't selected. The
+    pin change flag set by the edges of the last frame is cleared
+    before the sleep, and a start bit that is already there is hunted
+    by busy-polling. When %[skip] is 1, the loop is left after an
+    address byte of another node, and the caller skips the data
+    frames that follow it. */
+#define AVR_UART_GET_ADDRESSED_ASM_TMPL                                 \
+  "  clr  %[selected]                                 \n\t"       \
+  "1:                                                 \n\t"       \
+  ".if %[sleep]                                       \n\t"       \
+  "  tst  %[selected]                                 \n\t"       \
+  "  brne 7f                                          \n\t"       \
+  "0:out  %[pcifr], %[pcif]                           \n\t"       \
+  "  sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 7f                                          \n\t"       \
+  "  sei                                              \n\t"       \
+  "  sleep                                            \n\t"       \
+  "  cli                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 0b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[sleep_delay_b]",              \
+                 "%[sleep_delay_rest]")                           \
+  "  rjmp 8f                                          \n\t"       \
+  ".endif                                             \n\t"       \
+  "7:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 7b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "8:ldi  %[bits], 9                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 5b                                          \n\t"       \
+  "  brcc 6f                                          \n\t"       \
+  "  clr  %[selected]                                 \n\t"       \
+  "  cpse %[byte], %[address]                         \n\t"       \
+  ".if %[skip]                                        \n\t"       \
+  "  rjmp 9f                                          \n\t"       \
+  ".else                                              \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  ".endif                                             \n\t"       \
+  "  inc  %[selected]                                 \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "6:tst  %[selected]                                 \n\t"       \
+  "  breq 1b                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "9:                                                 \n\t"
+
+#define AVR_UART_GET_ADDRESSED_OUT_OPS                  \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [selected] "=&r" (selected),                        \
+    [n] "+r" (n),                                       \
+    [values] "+e" (values),                             \
+    "=m" (*values)
+
+#define AVR_UART_GET_ADDRESSED_IN_OPS                          \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [address] "r" (address),                                   \
+    [sleep] "M" (sleep),                                       \
+    [skip] "M" (skip),                                         \
+    [pcifr] "I" (AVR_UART_PCIFR_IO_ADDR),                      \
+    [pcif] "r" (uint8_t(AVR_UART_PCIF_BV)),                    \
+    [sleep_delay_b] "M" (sleep_delay / 3),                     \
+    [sleep_delay_rest] "M" (sleep_delay % 3),                  \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Channel of select(): the mask of its Rx pin, its index and the
+    delay to the middle of the first data bit. */
+#define AVR_UART_SELECT_CHANNEL(mask, channel, first)                   \
+  "  ldi  %[chmask], " mask "                         \n\t"       \
+  "  ldi  %[channel], " channel "                     \n\t"       \
+  "  ldi  %[bits], 8                                  \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[" first "_b]",                \
+                 "%[" first "_rest]")                             \
+  "  rjmp 2f                                          \n\t"
+
+/** Hunt a start bit on any of the %[n] Rx pins in %[pins] with one
+    'in' and receive the byte of the first pin that is low. The pins
+    are tested in order by 'sbrc', each test that is skipped costs 2
+    cycles, and the last channel is the one left after the tests. The
+    bits are sampled through the mask of the channel, so the loop is
+    the same for all the channels and it takes 7 cycles. */
+#define AVR_UART_SELECT_ASM_TMPL                                        \
+  "1:in   %[tmp], %[pinx]                             \n\t"       \
+  "  com  %[tmp]                                      \n\t"       \
+  "  andi %[tmp], %[pins]                             \n\t"       \
+  "  breq 1b                                          \n\t"       \
+  "  sbrc %[tmp], %[b0]                               \n\t"       \
+  "  rjmp 10f                                         \n\t"       \
+  ".if %[n] > 2                                       \n\t"       \
+  "  sbrc %[tmp], %[b1]                               \n\t"       \
+  "  rjmp 11f                                         \n\t"       \
+  ".endif                                             \n\t"       \
+  ".if %[n] > 3                                       \n\t"       \
+  "  sbrc %[tmp], %[b2]                               \n\t"       \
+  "  rjmp 12f                                         \n\t"       \
+  ".endif                                             \n\t"       \
+  AVR_UART_SELECT_CHANNEL("%[m_last]", "%[n] - 1", "first_last")  \
+  "10:                                                \n\t"       \
+  AVR_UART_SELECT_CHANNEL("%[m0]", "0", "first0")                 \
+  ".if %[n] > 2                                       \n\t"       \
+  "11:                                                \n\t"       \
+  AVR_UART_SELECT_CHANNEL("%[m1]", "1", "first1")                 \
+  ".endif                                             \n\t"       \
+  ".if %[n] > 3                                       \n\t"       \
+  "12:                                                \n\t"       \
+  AVR_UART_SELECT_CHANNEL("%[m2]", "2", "first2")                 \
+  ".endif                                             \n\t"       \
+  "2:in   %[tmp], %[pinx]                             \n\t"       \
+  "  and  %[tmp], %[chmask]                           \n\t"       \
+  "  cp   __zero_reg__, %[tmp]                        \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  dec  %[bits]                                     \n\t"       \
+  "  brne 2b                                          \n\t"
+
+#define AVR_UART_SELECT_OUT_OPS                         \
+  : [byte] "=&r" (byte),                                \
+    [channel] "=&d" (channel),                          \
+    [chmask] "=&d" (chmask),                            \
+    [bits] "=&d" (bits),                                \
+    [tmp] "=&d" (tmp),                                  \
+    [delay_cnt] "=&d" (delay_cnt)
+
+#define AVR_UART_SELECT_IN_OPS                                 \
+  : [pinx] "I" (pinx),                                         \
+    [pins] "M" (pins),                                         \
+    [n] "M" (n),                                               \
+    [b0] "I" (bit[0]),                                         \
+    [b1] "I" (bit[1]),                                         \
+    [b2] "I" (bit[2]),                                         \
+    [m0] "M" (1 << bit[0]),                                    \
+    [m1] "M" (1 << bit[1]),                                    \
+    [m2] "M" (1 << bit[2]),                                    \
+    [m_last] "M" (1 << bit[n - 1]),                            \
+    [first0_b] "M" (first[0] / 3),                             \
+    [first0_rest] "M" (first[0] % 3),                          \
+    [first1_b] "M" (first[1] / 3),                             \
+    [first1_rest] "M" (first[1] % 3),                          \
+    [first2_b] "M" (first[2] / 3),                             \
+    [first2_rest] "M" (first[2] % 3),                          \
+    [first_last_b] "M" (first[3] / 3),                         \
+    [first_last_rest] "M" (first[3] % 3),                      \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Receive %[n] bytes checking the start and stop bits. A line that
+    is already low at the entry is an overrun: a start bit began
+    before the call, and the byte is dropped waiting for the idle
+    line. A start bit that is high at its middle is a glitch, and the
+    start bit is hunted again. A low stop bit is a framing error, and
+    the line must be idle before the next byte or the return. The
+    errors are counted in %[fe], %[gl] and %[ov], which saturate at
+    255. */
+#define AVR_UART_GET_CHECKED_ASM_TMPL                                   \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1f                                          \n\t"       \
+  "  inc  %[ov]                                       \n\t"       \
+  "  brne 0f                                          \n\t"       \
+  "  dec  %[ov]                                       \n\t"       \
+  "0:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 0b                                          \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[half_delay_b]",               \
+                 "%[half_delay_rest]")                            \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 7f                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[fst_delay_b]",                \
+                 "%[fst_delay_rest]")                             \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:brcc 6f                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "  rjmp 8f                                          \n\t"       \
+  "7:inc  %[gl]                                       \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "  dec  %[gl]                                       \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "6:st   %a[values]+, %[byte]                        \n\t"       \
+  "  inc  %[fe]                                       \n\t"       \
+  "  brne 9f                                          \n\t"       \
+  "  dec  %[fe]                                       \n\t"       \
+  "9:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 9b                                          \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "8:                                                 \n\t"
+
+#define AVR_UART_GET_CHECKED_OUT_OPS                    \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [n] "+r" (n),                                       \
+    [fe] "+r" (fe),                                     \
+    [gl] "+r" (gl),                                     \
+    [ov] "+r" (ov),                                     \
+    [values] "+e" (values),                             \
+    "=m" (*values)
+
+#define AVR_UART_GET_CHECKED_IN_OPS                            \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [half_delay_b] "M" (half_delay / 3),                       \
+    [half_delay_rest] "M" (half_delay % 3),                    \
+    [fst_delay_b] "M" (fst_delay / 3),                         \
+    [fst_delay_rest] "M" (fst_delay % 3),                      \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Wait for the Rx line to be low during %[iterations] iterations of
+    6 cycles, and then for the end of the low level. */
+#define AVR_UART_WAIT_BREAK_ASM_TMPL                                    \
+  "0:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 0b                                          \n\t"       \
+  "  ldi  %A[cnt], lo8(%[iterations])                 \n\t"       \
+  "  ldi  %B[cnt], hi8(%[iterations])                 \n\t"       \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 0b                                          \n\t"       \
+  "  sbiw %[cnt], 1                                   \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "2:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 2b                                          \n\t"
+
+#define AVR_UART_WAIT_BREAK_OUT_OPS                     \
+  : [cnt] "=&w" (cnt)
+
+#define AVR_UART_WAIT_BREAK_IN_OPS                             \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [iterations] "i" (iterations)
+
+/** Receive up to %[n] bytes dropping the first %[skip] ones. The loop
+    takes 8 cycles like AVR_UART_GET_SEQ_ASM_TMPL, and the reception
+    stops if a stop bit is low, which happens with a framing error or
+    a break. When %[check] is 1, the first byte is a start code that
+    isn't counted by %[skip]: %[started] is set if it's equal to
+    %[code], otherwise the reception stops. */
+#define AVR_UART_GET_SKIP_ASM_TMPL                                      \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "2:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 2b                                          \n\t"       \
+  "5:brcc 4f                                          \n\t"       \
+  ".if %[check]                                       \n\t"       \
+  "  tst  %[started]                                  \n\t"       \
+  "  brne 6f                                          \n\t"       \
+  "  cpse %[byte], %[code]                            \n\t"       \
+  "  rjmp 4f                                          \n\t"       \
+  "  inc  %[started]                                  \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "6:                                                 \n\t"       \
+  ".endif                                             \n\t"       \
+  "  sbiw %[skip], 1                                  \n\t"       \
+  "  brcc 1b                                          \n\t"       \
+  "  adiw %[skip], 1                                  \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  sbiw %[n], 1                                     \n\t"       \
+  "  brne 1b                                          \n\t"       \
+  "4:                                                 \n\t"
+
+#define AVR_UART_GET_SKIP_OUT_OPS                       \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [skip] "+w" (skip),                                 \
+    [n] "+w" (n),                                       \
+    [values] "+e" (values),                             \
+    [started] "+r" (started),                           \
+    "=m" (*values)
+
+#define AVR_UART_GET_SKIP_IN_OPS                               \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [check] "M" (Check),                                       \
+    [code] "r" (code),                                         \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Receive bytes until the Rx line stays idle during %[iterations]
+    iterations of 6 cycles after a stop bit. The first start bit is
+    hunted without a timeout. Up to %[room] bytes are stored, and the
+    next ones are dropped. */
+#define AVR_UART_GET_FRAME_ASM_TMPL                                     \
+  "1:sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 1b                                          \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "2:ldi  %A[cnt], lo8(%[iterations])                 \n\t"       \
+  "  ldi  %B[cnt], hi8(%[iterations])                 \n\t"       \
+  "7:sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "  sbiw %[cnt], 1                                   \n\t"       \
+  "  brne 7b                                          \n\t"       \
+  "  rjmp 4f                                          \n\t"       \
+  "6:                                                 \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[one_half_delay_b]",           \
+                 "%[one_half_delay_rest]")                        \
+  "  ldi  %[bits], 9                                  \n\t"       \
+  "8:clc                                              \n\t"       \
+  "  sbic %[pinx], %[rx_pin]                          \n\t"       \
+  "  sec                                              \n\t"       \
+  "  dec  %[bits]                                     \n\t"       \
+  "  breq 5f                                          \n\t"       \
+  "  ror  %[byte]                                     \n\t"       \
+  AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]")   \
+  "  rjmp 8b                                          \n\t"       \
+  "5:tst  %[room]                                     \n\t"       \
+  "  breq 2b                                          \n\t"       \
+  "  st   %a[values]+, %[byte]                        \n\t"       \
+  "  dec  %[room]                                     \n\t"       \
+  "  rjmp 2b                                          \n\t"       \
+  "4:                                                 \n\t"
+
+#define AVR_UART_GET_FRAME_OUT_OPS                      \
+  : [byte] "=&r" (byte),                                \
+    [bits] "=&d" (bits),                                \
+    [delay_cnt] "=&d" (delay_cnt),                      \
+    [cnt] "=&w" (cnt),                                  \
+    [room] "+r" (room),                                 \
+    [values] "+e" (values),                             \
+    "=m" (*values)
+
+#define AVR_UART_GET_FRAME_IN_OPS                              \
+  : [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [iterations] "i" (iterations),                             \
+    [one_half_delay_b] "M" (one_half_delay / 3),               \
+    [one_half_delay_rest] "M" (one_half_delay % 3),            \
+    [delay_b] "M" (delay / 3),                                 \
+    [delay_rest] "M" (delay % 3)
+
+/** Full-duplex loop used by transfer_bytes(). A bit is split in four
+    ticks, and the Rx line is read at the beginning of each tick. The
+    state of the receiver is kept in %[s]: 0 means hunting for a
+    start bit, 1..8 is the number of data bits to be sampled, 0x80
+    means a received byte to be stored, and 0xc0 means that all bytes
+    were received. %[rt] counts the ticks until the next event of the
+    receiver. */
+#define AVR_UART_TRANSFER_ASM_TMPL                                      \
+  "  in   %[port], %[portx]                           \n\t"       \
+  "  cbr  %[port], %[mask]                            \n\t"       \
+  "  ld   %[tx], %a[src]+                             \n\t"       \
+  "  com  %[tx]                                       \n\t"       \
+  "  ldi  %[n], 10                                    \n\t"       \
+  "  clr  %[s]                                        \n\t"       \
+  "  ldi  %[rt], 1                                    \n\t"       \
+  "0:out  %[portx], %[port]                           \n\t"       \
+  "  lsr  %[tx]                                       \n\t"       \
+  "  cbr  %[port], %[mask]                            \n\t"       \
+  "  brcs 1f                                          \n\t"       \
+  "  sbr  %[port], %[mask]                            \n\t"       \
+  "1:                                                 \n\t"       \
+  AVR_UART_TRANSFER_RX_TICK                                       \
+  AVR_UART_DELAY("%[dly]", "%[d0_b]", "%[d0_rest]")               \
+  AVR_UART_TRANSFER_RX_TICK                                       \
+  AVR_UART_TRANSFER_TX_CTL                                        \
+  AVR_UART_DELAY("%[dly]", "%[d1_b]", "%[d1_rest]")               \
+  AVR_UART_TRANSFER_RX_TICK                                       \
+  AVR_UART_TRANSFER_RX_CTL                                        \
+  AVR_UART_DELAY("%[dly]", "%[d2_b]", "%[d2_rest]")               \
+  AVR_UART_TRANSFER_RX_TICK                                       \
+  AVR_UART_DELAY("%[dly]", "%[d3_b]", "%[d3_rest]")               \
+  "  sbrc %[s], 6                                     \n\t"       \
+  "  clr  %[rt]                                       \n\t"       \
+  "  mov  %[tmp], %[n]                                \n\t"       \
+  "  or   %[tmp], %[txc]                              \n\t"       \
+  "  sbrs %[s], 6                                     \n\t"       \
+  "  ori  %[tmp], 1                                   \n\t"       \
+  "  tst  %[tmp]                                      \n\t"       \
+  "  brne 0b                                          \n\t"
+
+/** 15 cycles in all paths */
+#define AVR_UART_TRANSFER_RX_TICK                                       \
+  "  in   %[tmp], %[pinx]                             \n\t"       \
+  "  dec  %[rt]                                       \n\t"       \
+  "  brne 8f                                          \n\t"       \
+  "  bst  %[tmp], %[rx_pin]                           \n\t"       \
+  "  tst  %[s]                                        \n\t"       \
+  "  breq 7f                                          \n\t"       \
+  "  lsr  %[rx]                                       \n\t"       \
+  "  bld  %[rx], 7                                    \n\t"       \
+  "  ldi  %[rt], 4                                    \n\t"       \
+  "  dec  %[s]                                        \n\t"       \
+  "  brne 6f                                          \n\t"       \
+  "  ldi  %[s], 0x80                                  \n\t"       \
+  "  clr  %[rt]                                       \n\t"       \
+  "  rjmp 9f                                          \n\t"       \
+  "6:nop                                              \n\t"       \
+  "  rjmp 9f                                          \n\t"       \
+  "7:ldi  %[rt], 1                                    \n\t"       \
+  "  brts 5f                                          \n\t"       \
+  "  ldi  %[rt], 6                                    \n\t"       \
+  "  ldi  %[s], 8                                     \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp 9f                                          \n\t"       \
+  "5:nop                                              \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp 9f                                          \n\t"       \
+  "8:ldi  %[dly], 3                                   \n\t"       \
+  "3:dec  %[dly]                                      \n\t"       \
+  "  brne 3b                                          \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "9:                                                 \n\t"
+
+/** 14 cycles in all paths */
+#define AVR_UART_TRANSFER_TX_CTL                                        \
+  "  cpse %[n], __zero_reg__                          \n\t"       \
+  "  dec  %[n]                                        \n\t"       \
+  "  tst  %[n]                                        \n\t"       \
+  "  brne 2f                                          \n\t"       \
+  "  tst  %[txc]                                      \n\t"       \
+  "  breq 4f                                          \n\t"       \
+  "  ld   %[tx], %a[src]+                             \n\t"       \
+  "  com  %[tx]                                       \n\t"       \
+  "  ldi  %[n], 10                                    \n\t"       \
+  "  cbr  %[port], %[mask]                            \n\t"       \
+  "  dec  %[txc]                                      \n\t"       \
+  "  rjmp 5f                                          \n\t"       \
+  "2:rjmp .                                           \n\t"       \
+  "4:rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  rjmp .                                           \n\t"       \
+  "  nop                                              \n\t"       \
+  "5:                                                 \n\t"
+
+/** 14 cycles in all paths, the 'st' is padded to 2 cycles on AVRxt */
+#define AVR_UART_TRANSFER_RX_CTL                                        \
+  "  cpi  %[s], 0x80                                  \n\t"       \
+  "  brne 2f                                          \n\t"       \
+  "  sbis %[pinx], %[rx_pin]                          \n\t"       \
+  "  rjmp 4f                                          \n\t"       \
+  "  st   %a[dst]+, %[rx]                             \n\t"       \
+  ".if %[st_cycles] == 1                              \n\t"       \
+  "  nop                                              \n\t"       \
+  ".endif                                             \n\t"       \
+  "  clr  %[s]                                        \n\t"       \
+  "  ldi  %[rt], 1                                    \n\t"       \
+  "  dec  %[rxc]                                      \n\t"       \
+  "  brne 5f                                          \n\t"       \
+  "  ldi  %[s], 0xc0                                  \n\t"       \
+  "  clr  %[rt]                                       \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "5:nop                                              \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "2:ldi  %[dly], 3                                   \n\t"       \
+  "3:dec  %[dly]                                      \n\t"       \
+  "  brne 3b                                          \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "4:ldi  %[dly], 2                                   \n\t"       \
+  "3:dec  %[dly]                                      \n\t"       \
+  "  brne 3b                                          \n\t"       \
+  "  nop                                              \n\t"       \
+  "  rjmp 6f                                          \n\t"       \
+  "6:                                                 \n\t"
+
+#define AVR_UART_TRANSFER_OUT_OPS                       \
+  : [port] "=&d" (port_value),                          \
+    [tx] "=&r" (tx),                                    \
+    [n] "=&d" (n),                                      \
+    [rx] "=&r" (rx),                                    \
+    [s] "=&d" (s),                                      \
+    [rt] "=&d" (rt),                                    \
+    [tmp] "=&d" (tmp),                                  \
+    [dly] "=&d" (dly),                                  \
+    [txc] "+r" (txc),                                   \
+    [rxc] "+r" (rxc),                                   \
+    [src] "+x" (src),                                   \
+    [dst] "+z" (dst),                                   \
+    "=m" (buffer)
+
+#define AVR_UART_TRANSFER_IN_OPS                               \
+  : [portx] "I" (TxPin::portx::io_addr()),                     \
+    [mask] "i" (TxPin::bv()),                                  \
+    [pinx] "I" (RxPin::pinx::io_addr()),                       \
+    [rx_pin] "I" (RxPin::value),                               \
+    [d0_b] "M" (d0 / 3), [d0_rest] "M" (d0 % 3),               \
+    [d1_b] "M" (d1 / 3), [d1_rest] "M" (d1 % 3),               \
+    [d2_b] "M" (d2 / 3), [d2_rest] "M" (d2 % 3),               \
+    [d3_b] "M" (d3 / 3), [d3_rest] "M" (d3 % 3),               \
+    [st_cycles] "M" (detail::core_timing::st),                 \
+    "m" (*(const uint8_t(*)[N])bytes)
+
 #define AVR_UART_DELAY_1_CYCLE "nop    \n\t"
 
 #define AVR_UART_DELAY_2_CYCLE "rjmp . \n\t"
@@ -103,6 +1240,41 @@
   "3:dec %[delay_cnt]                  \n\t"    \
   "  brne 3b                           \n\t"
 
+/** Delay of exactly 3 * b + rest CPU cycles, where rest is 0, 1 or
+    2. The arguments are operands of the asm template, for example:
+    AVR_UART_DELAY("%[delay_cnt]", "%[delay_b]", "%[delay_rest]").
+    The loop is only assembled when b > 0. */
+#define AVR_UART_DELAY(cnt, b, rest)              \
+  ".if " b " > 0                       \n\t"      \
+  "  ldi " cnt ", " b "                \n\t"      \
+  "3:dec " cnt "                       \n\t"      \
+  "  brne 3b                           \n\t"      \
+  ".endif                              \n\t"      \
+  ".if " rest " == 1                   \n\t"      \
+  "  nop                               \n\t"      \
+  ".elseif " rest " == 2               \n\t"      \
+  "  rjmp .                            \n\t"      \
+  ".endif                              \n\t"
+
+/** Delay of exactly 4 * b + 1 + rest CPU cycles using the 16-bit
+    counter operand named cnt, or rest cycles when b is 0. rest is a
+    number of nops. */
+#define AVR_UART_DELAY16(cnt, b, rest)            \
+  ".if " b " > 0                       \n\t"      \
+  "  ldi  %A[" cnt "], lo8(" b ")      \n\t"      \
+  "  ldi  %B[" cnt "], hi8(" b ")      \n\t"      \
+  "3:sbiw %[" cnt "], 1                \n\t"      \
+  "  brne 3b                           \n\t"      \
+  ".endif                              \n\t"      \
+  AVR_UART_NOPS(rest)
+
+/** n nops, where n is an immediate operand. Example:
+    AVR_UART_NOPS("%[g0]") */
+#define AVR_UART_NOPS(n)                          \
+  ".rept " n "                         \n\t"      \
+  "  nop                               \n\t"      \
+  ".endr                               \n\t"
+
 #define AVR_UART_DELAY_3_CYCLE_GET_SEQ                                       \
   "  ldi  %[one_half_delay_cnt], %[one_half_delay_after_fst_bit_b]     \n\t" \
   "1:dec  %[one_half_delay_cnt]                                        \n\t" \
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "avr/uart/soft.hpp"
+
+#include <stdint.h>
+
+namespace avr::uart {
+
+/**
+   [optional] DMX512 receiver that stores the slots of one fixture.
+
+   A DMX512 packet is a break, a mark after break, a start code and up
+   to 512 slots transmitted in a row at 250 kbps 8-N-2. The receiver
+   synchronizes on the break, drops the packets with a start code
+   different from zero, drops the slots before the start address and
+   stores only the Slots slots of the fixture. The start code and the
+   slots are received by the same loop of
+   soft::get_bytes_after(code, bytes, n, skip), so the first slot can
+   follow the start code in a row, and the bit length must be at
+   least 32 cycles: 8 MHz or 16 MHz.
+
+   Example:
+     //fixture with 3 channels at the start address 10
+     dmx_receiver<soft<Pb0, Pb1, 250_kbps, 8_MHz>, 3> rgb{10};
+     while(true) {
+       if(rgb.receive() == 3) set_color(rgb[0], rgb[1], rgb[2]);
+     }
+
+   Arguments:
+
+   Uart: soft device at 250 kbps used to receive the packets. The Tx
+         pin isn't used by the receiver.
+
+   Slots: number of slots of the fixture.
+ */
+template<typename Uart, uint16_t Slots>
+class dmx_receiver {
+  static_assert(Uart::bitrate == 250000,
+    "DMX512 is transmitted at 250 kbps.");
+
+  static_assert(Slots > 0 && Slots <= 512,
+    "a DMX512 packet has up to 512 slots.");
+
+  Uart _uart;
+  uint16_t _address;
+  uint8_t _slots[Slots];
+public:
+  static constexpr uint16_t size{Slots};
+
+  /** Start code of a packet with dimmer levels. */
+  static constexpr uint8_t null_start_code{0};
+
+  /** Indicates if v is a valid start address: from 1 to 512. */
+  static constexpr bool valid_address(uint16_t v)
+  { return v >= 1 && v <= 512; }
+
+  /** address: number of the first slot of the fixture, from 1 to
+      512. An invalid address is rejected and the receiver stays
+      without an address: address() returns 0 and receive() returns 0
+      without waiting for a packet. */
+  explicit dmx_receiver(uint16_t address)
+    : _address(valid_address(address) ? address : 0) {}
+
+  uint16_t address() const { return _address; }
+
+  /** Set the start address and return true, or return false and keep
+      the current one if v isn't valid. */
+  bool address(uint16_t v) {
+    if(!valid_address(v)) return false;
+    _address = v;
+    return true;
+  }
+
+  /** Wait for the next packet with the null start code and receive
+      the slots of the fixture. This is a blocking call that returns
+      the number of stored slots, which is less than Slots if the
+      packet is shorter than the start address plus Slots. The call
+      returns after the last slot of the fixture, so the application
+      can handle the slots while the rest of the packet is
+      transmitted. */
+  uint16_t receive() {
+    if(_address == 0) return 0;
+    while(true) {
+      /** Any low level longer than a frame is taken as a break. */
+      _uart.wait_break();
+      auto n = _uart.get_bytes_after(null_start_code, _slots, Slots,
+                                     _address - 1);
+      if(n >= 0) return n;
+    }
+  }
+
+  uint8_t operator[](uint16_t i) const { return _slots[i]; }
+  const uint8_t* data() const { return _slots; }
+};
+
+}//namespace avr::uart
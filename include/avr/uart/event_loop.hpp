@@ -0,0 +1,246 @@
+#pragma once
+
+#include "avr/uart/common.hpp"
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <stdint.h>
+
+/**
+   [optional] Cooperative event loop that dispatches the bytes of
+   several soft devices and the flags raised by interrupts(timers,
+   pin change) to their handlers without any allocation.
+
+   The sources are registered at compile time in priority order. Each
+   iteration tests the sources from the first one, runs the handler
+   of the first source that is ready and starts again from the first
+   source, so a handler is never interrupted by another one and a
+   source is always served before the ones that follow it.
+
+   A soft source is ready when its Rx line is low, and its handler
+   receives the byte with the interrupts disabled before it calls the
+   callable with the byte. The start bit is detected late when the
+   loop is running other handlers, and each data bit is sampled late
+   by the same number of cycles. The loop computes the worst latency
+   of each soft source from the declared cycles of the handlers and
+   of the ISRs: the longest handler, which can be running when the
+   start bit comes, plus the ISRs that raise the flags, which run
+   with the interrupts enabled while the loop polls, plus the
+   handlers of the flags that come before the source, plus the tests
+   of the sources. The latency must not exceed a quarter of the bit
+   length, which leaves the other quarter to the difference between
+   the clocks of the peers. run() checks it at compile time. The
+   guarantee assumes that two soft devices don't receive at the same
+   time, like the peers of a master that talk only when they are
+   asked, that a flag isn't raised twice during that latency, and
+   that the application doesn't enable other interrupts.
+
+   Example:
+     volatile bool tick{false};
+     ISR(TIM0_COMPA_vect, ISR_NAKED) {  // 17 cycles
+       asm volatile("push r24\n\tldi r24, 1\n\tsts %0, r24\n\t"
+                    "pop r24\n\treti" :: "i"(&tick));
+     }
+
+     soft<Pb4, Pb3, 57600_bps, 8_MHz> gps;
+     soft<Pb4, Pb2, 57600_bps, 8_MHz> modem;
+     event_loop loop{
+       on_byte<2>(gps, [&](uint8_t byte){ sum += byte; }),
+       on_byte<2>(modem, [&](uint8_t byte){ last = byte; }),
+       on_flag<2, 17>(tick, [&]{ ++seconds; })};
+     loop.run();
+
+   At 57600 bps @ 8 MHz the tolerance is 34 cycles: the longest
+   handler takes 2 + 10 cycles and the ISR of tick 17 cycles, which
+   is the latency of gps, and modem adds the 4 cycles of the test of
+   gps. An ISR written in C takes about 32 cycles, the default of
+   on_flag(), which doesn't fit in the tolerance of the bit lengths
+   that get() supports, so the flags of a loop with soft sources
+   should be raised by naked ISRs.
+
+   The cycles of a handler are the cycles of the callable, which
+   should be inlined like a consumer of soft::get_stream().
+   test_cycles and dispatch_cycles are estimates of the code
+   generated around the callables, isr_cycles is an estimate of an
+   ISR written in C, and they aren't checked against the generated
+   code, so the latencies should be confirmed in the listing of a
+   tight configuration.
+ */
+namespace avr::uart {
+
+namespace detail::event_loop {
+
+/** cycles to test a source that isn't ready and go to the next one */
+constexpr uint16_t test_cycles{4};
+
+/** cycles to enter and leave a handler besides its callable */
+constexpr uint16_t dispatch_cycles{10};
+
+/** cycles of an ISR that only sets a flag: the response and the
+    'rjmp' of the vector(6), the prologue and the epilogue of avr-gcc
+    with a scratch register(19), the store of the flag(3) and
+    'reti'(4). */
+constexpr uint16_t isr_cycles{32};
+
+template<typename T>
+constexpr T max(T a, T b) { return a > b ? a : b; }
+
+/** Sources in priority order. */
+template<typename... Sources>
+struct sources {
+  static constexpr uint16_t longest{0};
+  static constexpr uint16_t isr{0};
+
+  static constexpr uint32_t latency(uint32_t, uint32_t) { return 0; }
+  static constexpr bool meets(uint32_t, uint32_t) { return true; }
+
+  bool poll() { return false; }
+};
+
+template<typename Source, typename... Rest>
+struct sources<Source, Rest...> {
+  using rest_t = sources<Rest...>;
+
+  /** cycles of the longest handler */
+  static constexpr uint16_t longest{
+    max<uint16_t>(Source::cycles + dispatch_cycles, rest_t::longest)};
+
+  /** cycles of the ISRs that raise the flags, which can run once each
+      before a start bit is detected */
+  static constexpr uint16_t isr{Source::isr_cycles + rest_t::isr};
+
+  /** cycles spent by the loop before a soft source is tested after a
+      start bit, when before cycles are spent by the sources that come
+      before this one. */
+  static constexpr uint32_t next(uint32_t before) {
+    return before + test_cycles
+      + (Source::is_soft ? 0 : Source::cycles + dispatch_cycles);
+  }
+
+  /** worst latency to detect a start bit on the soft sources, when
+      running cycles can be spent by a handler and the ISRs */
+  static constexpr uint32_t latency(uint32_t before, uint32_t running) {
+    return max<uint32_t>(Source::is_soft ? running + before : 0,
+                         rest_t::latency(next(before), running));
+  }
+
+  static constexpr bool meets(uint32_t before, uint32_t running) {
+    if constexpr(Source::is_soft)
+      if(running + before > Source::tolerance) return false;
+    return rest_t::meets(next(before), running);
+  }
+
+  Source source;
+  rest_t rest;
+
+  explicit sources(Source s, Rest... r) : source(s), rest(r...) {}
+
+  [[gnu::always_inline]] bool poll() { return source() || rest.poll(); }
+};
+
+}//namespace detail::event_loop
+
+/** Source of the bytes received by a soft device. See on_byte(). */
+template<typename Uart, uint16_t Cycles, typename F>
+struct on_byte_t {
+  static constexpr bool is_soft{true};
+  static constexpr uint16_t cycles{Cycles};
+  static constexpr uint16_t isr_cycles{0};
+
+  /** latency in cycles to detect a start bit that is accepted */
+  static constexpr uint16_t tolerance{
+    uint16_t(bit_length_cycles(Uart::clk, Uart::bitrate) / 4)};
+
+  const Uart& uart;
+  F f;
+
+  [[gnu::always_inline]] bool operator()() {
+    if(Uart::rx_pin::is_high()) return false;
+    uint8_t sreg{SREG};
+    cli();
+    auto byte = uart.get();
+    SREG = sreg;
+    f(byte);
+    return true;
+  }
+};
+
+/** Handle each byte received by uart with f, which takes Cycles CPU
+    cycles. */
+template<uint16_t Cycles, typename Uart, typename F>
+constexpr on_byte_t<Uart, Cycles, F> on_byte(const Uart& uart, F f)
+{ return {uart, f}; }
+
+/** Source of a flag raised by an interrupt. See on_flag(). */
+template<typename Flag, uint16_t Cycles, uint16_t IsrCycles, typename F>
+struct on_flag_t {
+  static constexpr bool is_soft{false};
+  static constexpr uint16_t cycles{Cycles};
+  static constexpr uint16_t isr_cycles{IsrCycles};
+
+  Flag& flag;
+  F f;
+
+  [[gnu::always_inline]] bool operator()() {
+    if(!flag) return false;
+    flag = false;
+    f();
+    return true;
+  }
+};
+
+/** Call f, which takes Cycles CPU cycles, when flag is set and clear
+    it. flag is a volatile bool set by an ISR, like a compare match
+    of a timer or a pin change, which takes IsrCycles CPU cycles from
+    the interrupt to its 'reti'. */
+template<uint16_t Cycles,
+         uint16_t IsrCycles = detail::event_loop::isr_cycles,
+         typename Flag, typename F>
+constexpr on_flag_t<Flag, Cycles, IsrCycles, F> on_flag(Flag& flag, F f)
+{ return {flag, f}; }
+
+/** Event loop of the sources in priority order. See the description
+    at the top of this file. */
+template<typename... Sources>
+class event_loop {
+  static_assert(sizeof...(Sources) > 0,
+    "the event loop needs at least one source.");
+
+  using sources_t = detail::event_loop::sources<Sources...>;
+  sources_t _sources;
+public:
+  /** cycles of the longest handler, including the dispatch */
+  static constexpr uint16_t longest_handler_cycles{sources_t::longest};
+
+  /** cycles of the ISRs that raise the flags */
+  static constexpr uint16_t isr_cycles{sources_t::isr};
+
+  /** worst latency in cycles to detect a start bit on any soft
+      source */
+  static constexpr uint32_t max_latency_cycles{
+    sources_t::latency(0, sources_t::longest + sources_t::isr)};
+
+  /** true if no start bit can be detected later than the tolerance of
+      its soft source */
+  static constexpr bool no_missed_start_bit{
+    sources_t::meets(0, sources_t::longest + sources_t::isr)};
+
+  explicit event_loop(Sources... sources) : _sources(sources...) {}
+
+  /** Run the handler of the first source that is ready, if any, and
+      return true if one was run. This allows to run other code in
+      the loop, which isn't covered by no_missed_start_bit. */
+  [[gnu::always_inline]] bool poll() { return _sources.poll(); }
+
+  /** Dispatch the sources forever. */
+  [[noreturn]] void run() {
+    static_assert(no_missed_start_bit,
+      "a start bit can be detected later than a quarter of the bit "\
+      "length. Reduce the cycles of the handlers and of the ISRs or "\
+      "move the soft sources before the flags. "\
+      "[max_latency_cycles <= bit length/4]");
+    while(true) _sources.poll();
+  }
+};
+
+}//namespace avr::uart
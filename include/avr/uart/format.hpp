@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+   [optional] Output of numbers as ASCII text through a device with a
+   put() method, like avr::uart::soft or avr::uart::usi.
+
+   The digits are computed by repeated subtractions of powers of ten
+   and transmitted as soon as they are produced, so there is no
+   division and no buffer in RAM. The hex digits are computed without
+   a table.
+
+   Example:
+     put_dec(uart, uint16_t{1234});         //"1234"
+     put_dec(uart, int16_t{-5});            //"-5"
+     put_hex(uart, uint8_t{0x3f});          //"3F"
+     put_fixed<2>(uart, int16_t{-1234});    //"-12.34"
+ */
+namespace avr::uart {
+
+namespace detail::format {
+
+/** Transmit the decimal digits of value from the power of ten
+    10^(Digits - 1) down to 10^0. Leading zeros are suppressed up to
+    the digit 10^Point, and a '.' is transmitted before the digit
+    10^(Point - 1) when Point isn't zero. */
+template<uint8_t Digits, uint8_t Point, typename Uart>
+inline void put_udec(const Uart& uart, uint16_t value) {
+  constexpr uint16_t pows[]{10000, 1000, 100, 10, 1};
+  bool started{false};
+  for(uint8_t i{5 - Digits}; i < 5; ++i) {
+    uint8_t pos = 4 - i;
+    char digit{'0'};
+    while(value >= pows[i]) {
+      value -= pows[i];
+      ++digit;
+    }
+    if(digit != '0' || pos <= Point) started = true;
+    if(Point && pos == Point - 1) uart.put('.');
+    if(started) uart.put(digit);
+  }
+}
+
+[[gnu::always_inline]] inline char hex_digit(uint8_t nibble)
+{ return nibble < 10 ? '0' + nibble : 'A' - 10 + nibble; }
+
+}//namespace detail::format
+
+template<typename Uart>
+inline void put_dec(const Uart& uart, uint8_t value)
+{ detail::format::put_udec<3, 0>(uart, value); }
+
+template<typename Uart>
+inline void put_dec(const Uart& uart, uint16_t value)
+{ detail::format::put_udec<5, 0>(uart, value); }
+
+template<typename Uart>
+inline void put_dec(const Uart& uart, int16_t value) {
+  if(value < 0) uart.put('-');
+  detail::format::put_udec<5, 0>(
+    uart, value < 0 ? -uint16_t(value) : uint16_t(value));
+}
+
+template<typename Uart>
+inline void put_hex(const Uart& uart, uint8_t value) {
+  uart.put(detail::format::hex_digit(value >> 4));
+  uart.put(detail::format::hex_digit(value & 0x0f));
+}
+
+template<typename Uart>
+inline void put_hex(const Uart& uart, uint16_t value) {
+  put_hex(uart, uint8_t(value >> 8));
+  put_hex(uart, uint8_t(value));
+}
+
+/** Transmit a fixed-point number with Decimals fractional digits,
+    where value is the number multiplied by 10^Decimals. For example,
+    a temperature of 21.5 degrees stored as 215 is transmitted by
+    put_fixed<1>(uart, int16_t{215}). */
+template<uint8_t Decimals, typename Uart>
+inline void put_fixed(const Uart& uart, int16_t value) {
+  static_assert(Decimals > 0 && Decimals < 5);
+  if(value < 0) uart.put('-');
+  detail::format::put_udec<5, Decimals>(
+    uart, value < 0 ? -uint16_t(value) : uint16_t(value));
+}
+
+template<uint8_t Decimals, typename Uart>
+inline void put_fixed(const Uart& uart, uint16_t value) {
+  static_assert(Decimals > 0 && Decimals < 5);
+  detail::format::put_udec<5, Decimals>(uart, value);
+}
+
+}//namespace avr::uart
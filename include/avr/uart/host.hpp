@@ -0,0 +1,261 @@
+#pragma once
+
+#include "avr/uart/common.hpp"
+#include "avr/uart/detail/math.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/**
+   [optional] Host backend of avr::uart::soft to run the application
+   logic on a workstation, for example in unit tests or to profile
+   the timing of a protocol before the hardware exists.
+
+   The host doesn't execute the cycle-exact loops of soft, so the
+   calls advance a virtual clock(host::cycles) using the same bit
+   length in cycles of the AVR device: put() takes 10 bit lengths and
+   get() returns at the middle of the stop bit of the next frame on
+   Rx. The cycles spent by the application between two calls are
+   declared through host::delay_cycles(). Each level change of a pin
+   is recorded, and save_vcd() writes them as a VCD file that can be
+   opened by GTKWave to measure gaps and turnaround latencies.
+
+   The frames received by the application are scheduled on the Rx pin
+   by host::transmit(). A receiving method throws host::end_of_input
+   when there is no frame left, which ends a loop like while(true).
+
+   Example:
+     using namespace avr::uart;
+     using tx = host::pin<'t'>;
+     using rx = host::pin<'r'>;
+     host::soft<tx, rx, 115200_bps, 8_MHz> uart;
+     host::transmit<rx>(1000, 'a', uart.bit_length);
+     try {
+       while(true) {
+         auto byte = uart.get();
+         host::delay_cycles(40); //processing
+         uart.put(byte);
+       }
+     } catch(host::end_of_input) {}
+     host::save_vcd("echo.vcd", 8_MHz);
+
+   Only put(), get(), get_bytes<N>(), send_break() and wait_break()
+   are provided.
+ */
+namespace avr::uart::host {
+
+/** Virtual clock in CPU cycles shared by all the pins. */
+inline uint64_t cycles{0};
+
+/** Advance the virtual clock by the cycles spent by the application. */
+inline void delay_cycles(uint64_t n) { cycles += n; }
+
+/** Thrown when a receiving method waits for a start bit that will
+    never come. */
+struct end_of_input {};
+
+namespace detail {
+
+/** Level changes of a pin ordered by time. The level is high before
+    the first change. */
+using edges_t = std::vector<std::pair<uint64_t, bool>>;
+
+/** Pins that have at least one level change, used by save_vcd(). */
+inline std::vector<std::pair<char, const edges_t*>>& pins() {
+  static std::vector<std::pair<char, const edges_t*>> v;
+  return v;
+}
+
+}//namespace detail
+
+/**
+   Pin of the host backend with the interface of an avrIO pin used by
+   soft. Id identifies the pin in the VCD file and it must be a
+   printable character.
+ */
+template<char Id>
+struct pin {
+  static constexpr char id{Id};
+
+  static void out() {}
+  static void high() { drive(cycles, true); }
+  static void low() { drive(cycles, false); }
+  static bool is_high() { return level(cycles); }
+  static bool is_low() { return !is_high(); }
+
+  /** Change the level at the cycle at. A change scheduled before
+      other ones is inserted in order, which allows to feed an input
+      pin in advance. */
+  static void drive(uint64_t at, bool v) {
+    if(_edges.empty()) detail::pins().emplace_back(Id, &_edges);
+    auto it = std::upper_bound(
+      _edges.begin(), _edges.end(), at,
+      [](uint64_t t, const auto& e){ return t < e.first; });
+    _edges.emplace(it, at, v);
+  }
+
+  static bool level(uint64_t at) {
+    auto it = std::upper_bound(
+      _edges.begin(), _edges.end(), at,
+      [](uint64_t t, const auto& e){ return t < e.first; });
+    return it == _edges.begin() ? true : std::prev(it)->second;
+  }
+
+  /** Cycle of the first change to v at or after at, or at itself if
+      the level is already v. Returns false if there isn't one. */
+  static bool next_edge(uint64_t at, bool v, uint64_t& edge) {
+    if(level(at) == v) {
+      edge = at;
+      return true;
+    }
+    auto it = std::lower_bound(
+      _edges.begin(), _edges.end(), at,
+      [](const auto& e, uint64_t t){ return e.first < t; });
+    it = std::find_if(it, _edges.end(),
+                      [&](const auto& e){ return e.second == v; });
+    if(it == _edges.end()) return false;
+    edge = it->first;
+    return true;
+  }
+
+  static const detail::edges_t& edges() { return _edges; }
+private:
+  static inline detail::edges_t _edges;
+};
+
+/** Schedule a frame 8-N-1 of byte on Pin starting at the cycle at,
+    as it would be transmitted by a peer. Returns the cycle after the
+    stop bits. */
+template<typename Pin>
+inline uint64_t transmit(uint64_t at, uint8_t byte, double bit_length,
+                         uint8_t stop_bits = 1)
+{
+  auto edge = [&](uint8_t i){ return at + uint64_t(i * bit_length + 0.5); };
+  Pin::drive(edge(0), false);
+  for(uint8_t i{0}; i < 8; ++i)
+    Pin::drive(edge(i + 1), (byte >> i) & 1);
+  Pin::drive(edge(9), true);
+  return edge(9 + stop_bits);
+}
+
+/** Write the level changes of all the pins as a VCD file. The clock
+    frequency converts the cycles to nanoseconds. Returns false if the
+    file can't be written. */
+inline bool save_vcd(const char* path, uint32_t clk) {
+  auto f = std::fopen(path, "w");
+  if(!f) return false;
+  std::fprintf(f, "$timescale 1ns $end\n$scope module uart $end\n");
+  for(auto& p : detail::pins())
+    std::fprintf(f, "$var wire 1 %c pin_%c $end\n", p.first, p.first);
+  std::fprintf(f, "$upscope $end\n$enddefinitions $end\n#0\n");
+  for(auto& p : detail::pins()) std::fprintf(f, "1%c\n", p.first);
+
+  std::vector<std::pair<uint64_t, std::pair<char, bool>>> all;
+  for(auto& p : detail::pins())
+    for(auto& e : *p.second) all.push_back({e.first, {p.first, e.second}});
+  std::stable_sort(all.begin(), all.end(),
+    [](const auto& a, const auto& b){ return a.first < b.first; });
+
+  uint64_t last{0};
+  for(auto& c : all) {
+    auto ns = uint64_t(c.first * 1e9 / clk + 0.5);
+    if(ns != last) std::fprintf(f, "#%llu\n", (unsigned long long)ns);
+    last = ns;
+    std::fprintf(f, "%d%c\n", c.second.second, c.second.first);
+  }
+  return std::fclose(f) == 0;
+}
+
+/**
+   Host counterpart of avr::uart::soft. See the description at the top
+   of this file.
+
+   TxPin, RxPin: host::pin types.
+ */
+#ifdef F_CPU
+template<typename TxPin, typename RxPin, uint32_t baud_rate, uint32_t clk_cpu = F_CPU>
+#else
+template<typename TxPin, typename RxPin, uint32_t baud_rate, uint32_t clk_cpu>
+#endif
+struct soft {
+  using tx_pin = TxPin;
+  using rx_pin = RxPin;
+  static constexpr uint32_t bitrate = baud_rate;
+  static constexpr uint32_t clk = clk_cpu;
+
+  /** Exact bit length in cycles, which is used by a peer. */
+  static constexpr double bit_length{bit_length_cycles(clk, bitrate)};
+
+  /** Rounded CPU cycles required to transmit/receive a byte. */
+  static constexpr auto cycles_required{
+    avr::uart::detail::math::round(bit_length)};
+
+  soft() {
+    TxPin::out();
+    TxPin::high();
+  }
+
+  /** Transmit 1 byte through Tx. */
+  void put(uint8_t byte) const {
+    TxPin::low();
+    cycles += cycles_required;
+    for(uint8_t i{0}; i < 8; ++i) {
+      TxPin::drive(cycles, (byte >> i) & 1);
+      cycles += cycles_required;
+    }
+    TxPin::high();
+    cycles += cycles_required;
+  }
+
+  /** Receive 1 byte from Rx. The data bits are sampled at 1.5 bit
+      length from the falling edge of the start bit, or at the Phase
+      in percent of the bit, and then at each cycles_required
+      cycles. A start bit that began before the call is taken at the
+      call, like the busy-polling of soft does. */
+  template<uint8_t Phase = 50>
+  uint8_t get() const {
+    uint64_t start;
+    if(!RxPin::next_edge(cycles, false, start)) throw end_of_input{};
+    cycles = start + uint64_t((1 + Phase / 100.0) * bit_length + 0.5);
+    uint8_t byte{0};
+    for(uint8_t i{0}; i < 8; ++i) {
+      byte = (byte >> 1) | (RxPin::is_high() ? 0x80 : 0);
+      cycles += cycles_required;
+    }
+    return byte;
+  }
+
+  /** Receive N bytes. */
+  template<uint8_t N>
+  auto get_bytes() const {
+    buffer_t<N> buffer;
+    for(auto& b : buffer) b = get();
+    return buffer;
+  }
+
+  template<uint8_t Bits = 13, uint8_t MarkBits = 1>
+  void send_break() const {
+    TxPin::low();
+    cycles += uint64_t(Bits) * cycles_required;
+    TxPin::high();
+    cycles += uint64_t(MarkBits) * cycles_required;
+  }
+
+  /** Wait for a low level on Rx longer than Bits bit lengths and
+      return at its end. */
+  template<uint8_t Bits = 11>
+  void wait_break() const {
+    uint64_t fall, rise;
+    while(true) {
+      if(!RxPin::next_edge(cycles, false, fall)) throw end_of_input{};
+      if(!RxPin::next_edge(fall, true, rise)) throw end_of_input{};
+      cycles = rise;
+      if(rise - fall > uint64_t(Bits) * cycles_required) return;
+    }
+  }
+};
+
+}//namespace avr::uart::host
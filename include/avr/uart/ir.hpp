@@ -0,0 +1,160 @@
+#pragma once
+
+#include "avr/uart/common.hpp"
+#include "avr/uart/detail/inline_asm.hpp"
+#include "avr/uart/detail/math.hpp"
+
+#include <avr/io.hpp>
+#include <stdint.h>
+
+namespace avr::uart {
+
+/**
+   [optional] UART over an infrared link without an external
+   modulator, like IrDA SIR at 2400 to 9600 bps.
+
+   put() drives a carrier burst on Tx during each bit that is 0,
+   including the start bit, by toggling the pin inside the bit delay
+   loop, and keeps the pin low, with the LED off, during each bit that
+   is 1. The half period of the carrier is rounded to CPU cycles, and
+   each bit has an even number of half periods followed by a padding,
+   so the bit length is exact and the pin ends each burst low.
+
+   get() receives from the output of a TSOP-style receiver, which is
+   low while the carrier is present. The receiver detects a burst
+   after OnPeriods periods of the carrier and releases its output
+   OffPeriods periods after the end of the burst, so the low pulses
+   are stretched by OffPeriods - OnPeriods periods. The first data bit
+   is sampled at 1.5 bit length after the detected start bit plus
+   half of the stretch. The delays use 16-bit counters, so a bit can
+   take up to 65535 cycles.
+
+   A TSOP-style receiver needs bursts of about 6 to 10 periods of the
+   carrier, so 38 kHz fits 2400 and 4800 bps, and 9600 bps needs a
+   56 kHz carrier.
+
+   Example:
+     ir<Pb4, Pb3, 2400_bps, 38_kHz, 8_MHz> link;
+     link.put('a');
+     auto byte = link.get();
+
+   Arguments:
+
+   TxPin: avrIO pin type that drives the IR LED, active high.
+
+   RxPin: avrIO pin type connected to the output of the IR receiver.
+
+   baud_rate: bit rate of the link.
+
+   carrier: frequency of the carrier in Hz.
+
+   clk_cpu: CPU clock frequency. The F_CPU macro's value will be used
+            by default if it is defined.
+ */
+#ifdef F_CPU
+template<typename TxPin, typename RxPin, uint32_t baud_rate, uint32_t carrier,
+         uint32_t clk_cpu = F_CPU>
+#else
+template<typename TxPin, typename RxPin, uint32_t baud_rate, uint32_t carrier,
+         uint32_t clk_cpu>
+#endif
+struct ir {
+  using tx_pin = TxPin;
+  using rx_pin = RxPin;
+  static constexpr uint32_t bitrate = baud_rate;
+  static constexpr uint32_t clk = clk_cpu;
+
+  /** Rounded CPU cycles of a bit. */
+  static constexpr uint16_t cycles_required{
+    uint16_t(bit_length_cycles(clk, bitrate) + 0.5)};
+
+  /** Rounded CPU cycles of half of a period of the carrier. */
+  static constexpr uint16_t half_period{
+    uint16_t(clk / (2.0 * carrier) + 0.5)};
+
+  static_assert(half_period >= 5 && half_period <= 5 + 3 * 255,
+    "the half period of the carrier must be from 5 to 770 cycles. "\
+    "[5 <= clk_frequency/(2 * carrier) <= 770]");
+
+  /** Even number of half periods of the carrier in a bit. */
+  static constexpr uint16_t halfs_per_bit{
+    ((cycles_required - 7) / half_period) & ~1u};
+
+  static_assert(halfs_per_bit >= 2 && halfs_per_bit <= 254,
+    "a bit must have from 1 to 127 periods of the carrier. "\
+    "[1 <= carrier/baud_rate <= 127]");
+
+  /** Set up Tx pin as an output pin with the LED off. */
+  ir() {
+    TxPin::out();
+    TxPin::low();
+  }
+
+  /** Transmit 1 byte as carrier bursts through Tx. */
+  void put(uint8_t byte) const {
+    static_assert(TxPin::portx::io_addr() <= 0x3f,
+      "the Tx pin must be in the I/O space.");
+
+    /** 5 cycles of instructions in each half period */
+    constexpr uint16_t half_delay{half_period - 5};
+
+    /** cycles of a bit after the half periods and 7 cycles of
+     * instructions */
+    constexpr uint16_t pad
+      {cycles_required - 7 - halfs_per_bit * half_period};
+
+    static_assert(pad <= 3 * 255 + 2);
+
+    uint8_t port_state, toggle, bits, halfs, delay_cnt;
+    asm volatile(AVR_UART_IR_PUT_ASM_TMPL
+      AVR_UART_IR_PUT_OUT_OPS
+      AVR_UART_IR_PUT_IN_OPS
+    );
+  }
+
+  /** Receive 1 byte from the output of the IR receiver. This is a
+      blocking call.
+
+      OnPeriods, OffPeriods: latencies of the receiver in periods of
+      the carrier to detect a burst and to release the output after
+      it. See the datasheet of the receiver.
+   */
+  template<uint8_t OnPeriods = 7, uint8_t OffPeriods = 7>
+  uint8_t get() const {
+    static_assert(RxPin::pinx::io_addr() <= 0x3f,
+      "the Rx pin must be in the I/O space.");
+
+    constexpr double stretch
+      {(int16_t(OffPeriods) - int16_t(OnPeriods)) * double(clk) / carrier};
+
+    static_assert(stretch / 2 < 0.5 * bit_length_cycles(clk, bitrate)
+                  && -stretch / 2 < 0.5 * bit_length_cycles(clk, bitrate),
+      "the stretch of the pulses must be shorter than a bit.");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr uint16_t delay{cycles_required - 8};
+
+    /** 4 cycles of instructions before reaching the point of reading
+     * the bit. */
+    constexpr uint16_t first{uint16_t(
+      1.5 * bit_length_cycles(clk, bitrate) + stretch / 2 - 4 + 0.5)};
+
+    uint8_t byte, bits;
+    uint16_t cnt;
+    asm volatile(AVR_UART_IR_GET_ASM_TMPL
+      AVR_UART_IR_GET_OUT_OPS
+      AVR_UART_IR_GET_IN_OPS
+    );
+    return byte;
+  }
+private:
+  /** iterations of a delay of n cycles by AVR_UART_DELAY16() */
+  static constexpr uint16_t delay16_b(uint16_t n)
+  { return n >= 5 ? (n - 1) / 4 : 0; }
+
+  /** nops of a delay of n cycles by AVR_UART_DELAY16() */
+  static constexpr uint8_t delay16_rest(uint16_t n)
+  { return n >= 5 ? (n - 1) % 4 : n; }
+};
+
+}//namespace avr::uart
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "avr/uart/soft.hpp"
+
+#include <stdint.h>
+
+/**
+   [optional] Manchester-coded bursts between two soft devices, which
+   tolerate a large difference between the clocks of the peers, like
+   two uncalibrated RC oscillators.
+
+   Each bit is transmitted with the complement of its value in the
+   first half and its value in the second half(IEEE 802.3), so there
+   is a transition at the middle of each bit. A burst is a start bit
+   0, whose first half is the idle line, followed by the bits of the
+   bytes from the LSB without any gap, and the line returns to idle
+   at the end of the last bit. The bytes at the boundaries have the
+   same bit length of the others.
+
+   The receiver hunts the falling edge at the middle of the start bit
+   and samples each bit in its first half, at 2/3 of the bit length
+   after the edge at the middle of the previous bit, because that
+   half is the complement of the bit. After the sample it waits for
+   the edge at the middle of the bit and starts again from it, so
+   the phase is locked again at each bit and the error doesn't
+   accumulate through the burst. The sample must come after the
+   boundary between the bits and before the next edge minus the 14
+   cycles to store a byte and to detect the edge, so the tolerated
+   difference between the clocks is 1/3 - 28/(3 * bit length in
+   cycles). It's ±10% at 40 cycles per bit, about ±20% at 70 cycles,
+   and it approaches ±33% at low rates. See manchester_tolerance().
+
+   The line can change twice per bit, so the link needs twice the
+   bandwidth of a plain frame at the same bit rate, and a peer with a
+   UART or soft::get() can't read the bursts.
+
+   Example:
+     soft<Pb4, Pb3, 115200_bps, 8_MHz> uart;
+     uint8_t frame[32];
+     put_manchester(uart, frame, sizeof(frame));
+     get_manchester(uart, frame, sizeof(frame));
+
+   Requirements:
+     1. The Tx and Rx pins are in the I/O space.
+     2. The bit length is at least 40 cycles.
+     3. The receiver is waiting before the sender starts, and it
+        knows the number of bytes of the burst.
+
+   These are blocking calls, and the interrupts should be disabled
+   like in any other call of the soft device.
+ */
+namespace avr::uart {
+
+/** Tolerated relative difference between the clocks of the peers of a
+    Manchester burst at the bit rate of Uart. */
+template<typename Uart>
+constexpr double manchester_tolerance()
+{ return 1.0 / 3 - 28 / (3 * bit_length_cycles(Uart::clk, Uart::bitrate)); }
+
+/** Transmit n bytes as a Manchester burst through the Tx pin of uart. */
+template<typename Uart>
+inline void put_manchester(const Uart&, const uint8_t* bytes, uint8_t n) {
+  static_assert(Uart::tx_pin::portx::io_addr() <= 0x3f,
+    "the Tx pin must be in the I/O space.");
+
+  constexpr auto bit{bit_length_cycles(Uart::clk, Uart::bitrate)};
+  static_assert(bit >= 40,
+    "the bit length in cycles must be greater or equal to 40. "\
+    "[clk_frequency/baud_rate >= 40]");
+
+  constexpr uint16_t cycles{uint16_t(bit + 0.5)};
+  constexpr uint16_t half{uint16_t(bit / 2 + 0.5)};
+
+  /** 4 cycles of instructions in the first half of a bit, and 14
+   * cycles in the second half. The second half of the start bit has
+   * 4 cycles of instructions. */
+  constexpr uint16_t first{half - 4};
+  constexpr uint16_t second{cycles - half - 14};
+  constexpr uint16_t start{second + 10};
+
+  if(n == 0) return;
+
+  uint8_t byte, port_state, bits, delay_cnt;
+  asm volatile(AVR_UART_MANCHESTER_PUT_ASM_TMPL
+    AVR_UART_MANCHESTER_PUT_OUT_OPS
+    AVR_UART_MANCHESTER_PUT_IN_OPS
+  );
+}
+
+/** Receive a Manchester burst of n bytes from the Rx pin of uart. */
+template<typename Uart>
+inline void get_manchester(const Uart&, uint8_t* bytes, uint8_t n) {
+  static_assert(Uart::rx_pin::pinx::io_addr() <= 0x3f,
+    "the Rx pin must be in the I/O space.");
+
+  constexpr auto bit{bit_length_cycles(Uart::clk, Uart::bitrate)};
+  static_assert(bit >= 40,
+    "the bit length in cycles must be greater or equal to 40. "\
+    "[clk_frequency/baud_rate >= 40]");
+
+  /** The sample is at the same ratio of the bit length from the
+   * boundary between the bits and from the next edge minus 14
+   * cycles, and 4 cycles are spent from the edge to the delay. */
+  constexpr uint16_t delay{uint16_t((2 * bit - 14) / 3 - 4 + 0.5)};
+
+  if(n == 0) return;
+
+  uint8_t byte, bits, delay_cnt;
+  asm volatile(AVR_UART_MANCHESTER_GET_ASM_TMPL
+    AVR_UART_MANCHESTER_GET_OUT_OPS
+    AVR_UART_MANCHESTER_GET_IN_OPS
+  );
+}
+
+}//namespace avr::uart
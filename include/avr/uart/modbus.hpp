@@ -0,0 +1,186 @@
+#pragma once
+
+#include "avr/uart/soft.hpp"
+
+#include <stdint.h>
+#include <util/crc16.h>
+
+namespace avr::uart {
+
+namespace detail::modbus {
+
+[[gnu::always_inline]] inline uint16_t be16(const uint8_t* p)
+{ return uint16_t(p[0]) << 8 | p[1]; }
+
+}//namespace detail::modbus
+
+/**
+   [optional] Modbus RTU slave that serves a table of holding
+   registers through an avr::uart::soft device.
+
+   A request is received by soft::get_frame(), which ends the frame
+   when the line stays idle during 3.5 characters(t3.5), or 1.75 ms
+   above 19200 bps. The CRC-16 of the request is checked after the
+   end of the frame, which takes about 60 cycles per byte, and the
+   answer is transmitted right after it. The CRC-16 of the answer is
+   updated in the second stop bit of each byte, so it doesn't add a
+   gap between the bytes.
+
+   Supported function codes:
+   - 3: read holding registers
+   - 6: write single register
+   - 16: write multiple registers
+
+   The other ones are answered with the exception 'illegal function'.
+   A request to the broadcast address 0 is executed without an answer.
+
+   The frames are transmitted as 8-N-2, which is the format required
+   by Modbus when there is no parity, and frames with a parity bit
+   aren't supported.
+
+   Example:
+     uint16_t regs[8];
+     modbus_slave<soft<Pb4, Pb3, 115200_bps, 8_MHz>> slave{0x11, regs, 8};
+     while(true)
+       if(slave.poll() == 6) apply_settings(regs);
+
+   Arguments:
+
+   Uart: soft device used to receive and transmit the frames. The bit
+         length must be at least 24 cycles.
+
+   BufferSize: size of the buffer that stores a request. A longer
+               request is dropped because its CRC-16 can't be checked.
+ */
+template<typename Uart, uint8_t BufferSize = 64>
+class modbus_slave {
+  static_assert(BufferSize >= 8,
+    "the buffer must store at least a request of 8 bytes.");
+
+  Uart _uart;
+  uint8_t _address;
+  uint16_t* _registers;
+  uint16_t _count;
+  uint8_t _frame[BufferSize];
+  uint16_t _crc;
+
+  /** Lower bound of the cycles of _crc16_update(): 2 cycles and 8
+      iterations of 7 cycles, minus the last branch. */
+  static constexpr uint32_t crc16_cycles{57};
+
+  void put(uint8_t byte) {
+    _uart.put(byte);
+    /** second stop bit, which includes the update of the CRC-16 */
+    _crc = _crc16_update(_crc, byte);
+    __builtin_avr_delay_cycles(Uart::cycles_required > crc16_cycles
+                               ? Uart::cycles_required - crc16_cycles : 0);
+  }
+
+  void put16(uint16_t value) {
+    put(value >> 8);
+    put(value);
+  }
+
+  void begin_answer(uint8_t function) {
+    _crc = 0xffff;
+    put(_address);
+    put(function);
+  }
+
+  void end_answer() {
+    uint16_t crc{_crc};
+    put(crc);
+    put(crc >> 8);
+  }
+
+  void answer_exception(uint8_t function, uint8_t code) {
+    begin_answer(function | 0x80);
+    put(code);
+    end_answer();
+  }
+
+  /** Execute the request stored in the frame without the CRC-16 and
+      return the exception code or 0. */
+  uint8_t execute(uint8_t len, bool broadcast) {
+    using detail::modbus::be16;
+    auto function = _frame[1];
+    auto reg = be16(&_frame[2]);
+    auto qty = be16(&_frame[4]);
+    if(function == 3) {
+      if(len != 6 || qty == 0 || qty > 125) return illegal_data_value;
+      if(reg >= _count || qty > _count - reg) return illegal_data_address;
+      if(broadcast) return 0;
+      begin_answer(function);
+      put(qty * 2);
+      for(uint16_t i{0}; i < qty; ++i) put16(_registers[reg + i]);
+      end_answer();
+    } else if(function == 6) {
+      if(len != 6) return illegal_data_value;
+      if(reg >= _count) return illegal_data_address;
+      _registers[reg] = qty;
+      if(broadcast) return 0;
+      begin_answer(function);
+      put16(reg);
+      put16(qty);
+      end_answer();
+    } else if(function == 16) {
+      if(len < 7 || qty == 0 || qty > 123 || _frame[6] != qty * 2
+         || len != 7 + _frame[6])
+        return illegal_data_value;
+      if(reg >= _count || qty > _count - reg) return illegal_data_address;
+      for(uint16_t i{0}; i < qty; ++i)
+        _registers[reg + i] = be16(&_frame[7 + i * 2]);
+      if(broadcast) return 0;
+      begin_answer(function);
+      put16(reg);
+      put16(qty);
+      end_answer();
+    } else return illegal_function;
+    return 0;
+  }
+public:
+  static constexpr uint8_t broadcast_address{0};
+
+  /** exception codes */
+  static constexpr uint8_t illegal_function{1};
+  static constexpr uint8_t illegal_data_address{2};
+  static constexpr uint8_t illegal_data_value{3};
+
+  /** Silence that ends a frame: 3.5 characters of 11 bits, or 1.75
+      ms above 19200 bps. */
+  static constexpr uint32_t silence_cycles{
+    Uart::bitrate > 19200
+    ? uint32_t(1750e-6 * Uart::clk)
+    : uint32_t(38.5 * bit_length_cycles(Uart::clk, Uart::bitrate))};
+
+  /** address: slave address from 1 to 247.
+
+      registers: table of count holding registers. The register
+      address 0 is the first element. */
+  modbus_slave(uint8_t address, uint16_t* registers, uint16_t count)
+    : _address(address), _registers(registers), _count(count) {}
+
+  /** Receive a request and answer it if it is addressed to this
+      slave. This is a blocking call that waits for the next
+      frame. Returns the function code of an executed request, or 0
+      if the frame was dropped or answered with an exception. */
+  uint8_t poll() {
+    auto n = _uart.template get_frame<silence_cycles>(_frame, BufferSize);
+    if(n < 4) return 0;
+    uint16_t crc{0xffff};
+    for(uint8_t i{0}; i < n; ++i) crc = _crc16_update(crc, _frame[i]);
+    /** The CRC-16 of a frame that includes its CRC-16 is zero. */
+    if(crc != 0) return 0;
+    auto address = _frame[0];
+    bool broadcast{address == broadcast_address};
+    if(address != _address && !broadcast) return 0;
+    auto function = _frame[1];
+    if(auto exception = execute(n - 2, broadcast)) {
+      if(!broadcast) answer_exception(function, exception);
+      return 0;
+    }
+    return function;
+  }
+};
+
+}//namespace avr::uart
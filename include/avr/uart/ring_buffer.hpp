@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace avr::uart {
+
+/** FIFO of bytes with a fixed capacity
+
+    The indexes are wrapped using a mask, so Size must be a power of
+    two. One slot is kept empty to tell a full buffer from an empty
+    one, so Size - 1 bytes can be stored.
+ */
+template<uint8_t Size>
+class ring_buffer {
+  static_assert(Size >= 2 && (Size & (Size - 1)) == 0,
+    "the size of the ring buffer must be a power of two.");
+
+  static constexpr uint8_t mask{Size - 1};
+  uint8_t _data[Size];
+  uint8_t _head{0}, _tail{0};
+public:
+  static constexpr uint8_t capacity{Size - 1};
+
+  [[gnu::always_inline]] bool empty() const { return _head == _tail; }
+
+  [[gnu::always_inline]] bool full() const
+  { return ((_head + 1) & mask) == _tail; }
+
+  /** Number of stored bytes */
+  [[gnu::always_inline]] uint8_t size() const
+  { return (_head - _tail) & mask; }
+
+  /** Store byte if there is room for it. Returns false if the buffer
+      is full. */
+  [[gnu::always_inline]] bool push(uint8_t byte) {
+    uint8_t next = (_head + 1) & mask;
+    if(next == _tail) return false;
+    _data[_head] = byte;
+    _head = next;
+    return true;
+  }
+
+  /** Remove and return the oldest byte. The buffer must not be
+      empty. */
+  [[gnu::always_inline]] uint8_t pop() {
+    uint8_t byte = _data[_tail];
+    _tail = (_tail + 1) & mask;
+    return byte;
+  }
+};
+
+}//namespace avr::uart
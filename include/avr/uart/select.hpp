@@ -0,0 +1,104 @@
+#pragma once
+
+#include "avr/uart/soft.hpp"
+
+#include <stdint.h>
+
+namespace avr::uart {
+
+/** Byte returned by select() and the index of the device that
+    received it. */
+struct select_result {
+  uint8_t channel;
+  uint8_t byte;
+};
+
+/**
+   [optional] Wait for a start bit on the Rx pins of 2 to 4 soft
+   devices and receive the byte of the first one that starts.
+
+   The start bit is hunted on all the pins with one 'in' of the
+   common PINx register in a loop of 5 cycles, like a poll() or
+   select() on several file descriptors. The byte is received by the
+   same cycle-exact loop of get(), and the delay to the middle of the
+   first data bit is compensated by the cycles spent to find out
+   which pin is low. The returned channel is the index of the device
+   in the arguments.
+
+   Example:
+     soft<Pb0, Pb1, 9600_bps, 1_MHz> gps;
+     soft<Pb0, Pb2, 9600_bps, 1_MHz> modem;
+     while(true) {
+       auto [channel, byte] = select(gps, modem);
+       if(channel == 0) parse_nmea(byte);
+       else handle_modem(byte);
+     }
+
+   Requirements:
+     1. The Rx pins are in the same port and in the I/O space.
+     2. The devices have the same bit rate and CPU clock.
+     3. The bit length is at least 12 cycles.
+
+   This is a blocking call. When two devices start at the same time,
+   the device that comes first in the arguments is received and the
+   byte of the other one is lost. The call returns at the middle of
+   the last data bit, so there is half of a bit plus the stop bit to
+   call select() again without losing the next start bit.
+ */
+template<typename Uart, typename... Uarts>
+inline select_result select(const Uart&, const Uarts&...) {
+  constexpr uint8_t n{1 + sizeof...(Uarts)};
+  static_assert(n >= 2 && n <= 4,
+    "select() waits on 2 to 4 devices.");
+
+  constexpr auto bitrate{Uart::bitrate};
+  constexpr auto clk{Uart::clk};
+  static_assert(((Uarts::bitrate == bitrate) && ...)
+                && ((Uarts::clk == clk) && ...),
+    "the devices must have the same bit rate and CPU clock.");
+
+  constexpr uint8_t pinx{Uart::rx_pin::pinx::io_addr()};
+  static_assert(((Uarts::rx_pin::pinx::io_addr() == pinx) && ...),
+    "the Rx pins must be in the same port.");
+  static_assert(pinx <= 0x3f,
+    "the Rx pins must be in the I/O space.");
+
+  constexpr uint8_t pins{(Uart::rx_pin::bv() | ... | Uarts::rx_pin::bv())};
+  static_assert(__builtin_popcount(pins) == n,
+    "the Rx pins must be different.");
+
+  static_assert(bit_length_cycles(clk, bitrate) >= 12,
+    "the bit length in cycles must be greater or equal to 12. "\
+    "[clk_frequency/baud_rate >= 12]");
+
+  static_assert(1.5 * bit_length_cycles(clk, bitrate) - 14 < 255.5,
+    "the 1.5 bit length minus 14 cycles must be less than 256 "\
+    "cycles.");
+
+  constexpr uint8_t bit[]{Uart::rx_pin::value, Uarts::rx_pin::value..., 0, 0};
+
+  /** 4 cycles from the 'in' that finds the start bit to the tests of
+   * the pins, 2 cycles for each test skipped, 3 cycles for the test
+   * that is taken, 5 cycles to set up the channel and to jump to the
+   * loop, plus 2 cycles as the mean latency to detect the start bit
+   * with a loop of 5 cycles. The last channel doesn't have its own
+   * test. */
+  constexpr auto one_half{1.5 * bit_length_cycles(clk, bitrate)};
+  constexpr uint8_t first[]{
+    detail::math::round(one_half - 14),
+    detail::math::round(one_half - 16),
+    n > 3 ? detail::math::round(one_half - 18) : uint8_t{0},
+    detail::math::round(one_half - 9 - 2 * n)};
+
+  /** loop instructions executed in 7 cycles */
+  constexpr auto delay{Uart::cycles_required - 7};
+
+  uint8_t byte, channel, chmask, bits, tmp, delay_cnt;
+  asm volatile(AVR_UART_SELECT_ASM_TMPL
+    AVR_UART_SELECT_OUT_OPS
+    AVR_UART_SELECT_IN_OPS
+  );
+  return {channel, byte};
+}
+
+}//namespace avr::uart
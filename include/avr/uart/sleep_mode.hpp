@@ -0,0 +1,202 @@
+#pragma once
+
+#include <avr/io.h>
+#include <avr/sleep.h>
+#include <stdint.h>
+
+#if defined(GIMSK) //ATtiny13A, ATtiny25/45/85
+#define AVR_UART_PCIFR_IO_ADDR _SFR_IO_ADDR(GIFR)
+#define AVR_UART_PCIF_BV _BV(PCIF)
+#elif defined(PCICR) //ATmega48/88/168/328, ATmega2560
+#define AVR_UART_PCIFR_IO_ADDR _SFR_IO_ADDR(PCIFR)
+#define AVR_UART_PCIF_BV _BV(PCIF0)
+#else //not supported, see detail::pcint::enable()
+#define AVR_UART_PCIFR_IO_ADDR 0
+#define AVR_UART_PCIF_BV 0
+#endif
+
+namespace avr::uart {
+
+/**
+   Sleep modes that can be used by soft::sleep_get() and
+   soft::sleep_get_bytes() while waiting for a start bit.
+
+   Each mode describes the value to be used by set_sleep_mode() and
+   the CPU cycles between the falling edge of the start bit on the Rx
+   pin and the first instruction executed after the 'sleep'
+   instruction. This last value is subtracted from the 1.5 bit length
+   delay to sample the first data bit.
+
+   The application must define an empty pin change interrupt handler
+   that only executes a 'reti', for example:
+
+     EMPTY_INTERRUPT(PCINT0_vect);
+
+   A custom mode can be used to inform a measured latency:
+
+     struct my_power_down : sleep_mode::power_down {
+       static constexpr uint8_t wake_up_cycles{30};
+     };
+ */
+namespace sleep_mode {
+
+namespace detail {
+
+/** Cycles from the PCINT flag to the first instruction after the
+    'sleep': response time + 4 cycles due to the sleep + the jump
+    in the interrupt vector + 'reti' */
+#if defined(__AVR_3_BYTE_PC__)
+constexpr uint8_t isr_cycles{5 + 4 + 3 + 5};
+#elif defined(__AVR_HAVE_JMP_CALL__)
+constexpr uint8_t isr_cycles{4 + 4 + 3 + 4};
+#else
+constexpr uint8_t isr_cycles{4 + 4 + 2 + 4};
+#endif
+
+/** Cycles to synchronize the pin change with the clock and set the
+    PCINT flag. */
+constexpr uint8_t pcint_sync_cycles{3};
+
+}//namespace detail
+
+/** Only the CPU clock is halted, so there is no start-up time. */
+struct idle {
+  static constexpr uint8_t mode{SLEEP_MODE_IDLE};
+
+  static constexpr uint8_t wake_up_cycles{
+    detail::pcint_sync_cycles + detail::isr_cycles};
+};
+
+struct power_down {
+  static constexpr uint8_t mode{SLEEP_MODE_PWR_DOWN};
+
+  /** start-up time from power-down of the internal RC oscillator
+      using the default SUT fuses(6 CK) */
+  static constexpr uint8_t wake_up_cycles{
+    detail::pcint_sync_cycles + 6 + detail::isr_cycles};
+};
+
+}//namespace sleep_mode
+
+namespace detail::pcint {
+
+/** Enable the pin change interrupt of the pin Pin. Only the pins of
+    the bank PCINT0..7 are supported. */
+template<typename Pin>
+[[gnu::always_inline]] inline void enable() {
+#if defined(GIMSK)
+  PCMSK |= Pin::bv();
+  GIMSK |= _BV(PCIE);
+#elif defined(PCICR)
+  PCMSK0 |= Pin::bv();
+  PCICR |= _BV(PCIE0);
+#else
+  static_assert(!sizeof(Pin*),
+    "avrUART: pin change interrupt isn't supported by this MCU");
+#endif
+}
+
+/** Disable the pin change interrupt of the pin Pin. */
+template<typename Pin>
+[[gnu::always_inline]] inline void disable() {
+#if defined(GIMSK)
+  PCMSK &= ~Pin::bv();
+#elif defined(PCICR)
+  PCMSK0 &= ~Pin::bv();
+#endif
+}
+
+/** Pin change interrupt masks of the bank PCINT0..7, saved before
+    enable() and restored after the reception, so the Rx pin doesn't
+    keep raising the interrupt when the application runs with the
+    interrupts enabled. */
+struct masks {
+#if defined(GIMSK)
+  uint8_t pcmsk{PCMSK}, pcie{uint8_t(GIMSK & _BV(PCIE))};
+
+  [[gnu::always_inline]] void restore() const {
+    PCMSK = pcmsk;
+    GIMSK = (GIMSK & ~_BV(PCIE)) | pcie;
+  }
+#elif defined(PCICR)
+  uint8_t pcmsk{PCMSK0}, pcie{uint8_t(PCICR & _BV(PCIE0))};
+
+  [[gnu::always_inline]] void restore() const {
+    PCMSK0 = pcmsk;
+    PCICR = (PCICR & ~_BV(PCIE0)) | pcie;
+  }
+#else
+  void restore() const {}
+#endif
+};
+
+/** Clear a pending pin change interrupt flag. */
+[[gnu::always_inline]] inline void clear_flag() {
+#if defined(GIMSK)
+  GIFR = AVR_UART_PCIF_BV;
+#elif defined(PCICR)
+  PCIFR = AVR_UART_PCIF_BV;
+#endif
+}
+
+}//namespace detail::pcint
+
+/**
+   Timers that wake up the CPU from the idle mode after a number of
+   ticks while the pin change interrupt of Rx is disabled. See
+   soft::sleep_get_addressed().
+ */
+namespace wake_timer {
+
+/**
+   Timer/Counter0 as a one-shot timer using the compare match A.
+   Prescaler is 1, 8, 64, 256 or 1024. The timer is stopped when
+   it isn't used, so it can't be shared with the application.
+
+   The application must define an empty handler to the interrupt of
+   the compare match, for example:
+
+     EMPTY_INTERRUPT(TIM0_COMPA_vect); //ATtiny25/45/85, ATtiny13A
+     EMPTY_INTERRUPT(TIMER0_COMPA_vect); //ATmega
+ */
+template<uint16_t Prescaler = 8>
+struct timer0 {
+  static_assert(Prescaler == 1 || Prescaler == 8 || Prescaler == 64
+                || Prescaler == 256 || Prescaler == 1024,
+    "the prescaler of the Timer/Counter0 is 1, 8, 64, 256 or 1024.");
+
+  static constexpr uint16_t prescaler{Prescaler};
+
+  /** Start counting from zero up to ticks. */
+  [[gnu::always_inline]] static void start(uint8_t ticks) {
+    constexpr uint8_t cs{Prescaler == 1 ? 1 : Prescaler == 8 ? 2
+                         : Prescaler == 64 ? 3 : Prescaler == 256 ? 4 : 5};
+    TCCR0A = 0;
+    TCNT0 = 0;
+    OCR0A = ticks;
+#if defined(TIMSK0)
+    TIFR0 = _BV(OCF0A);
+    TIMSK0 |= _BV(OCIE0A);
+#else
+    TIFR = _BV(OCF0A);
+    TIMSK |= _BV(OCIE0A);
+#endif
+    TCCR0B = cs;
+  }
+
+  /** Indicates if the counter reached the ticks of start(). */
+  [[gnu::always_inline]] static bool expired() { return TCNT0 >= OCR0A; }
+
+  [[gnu::always_inline]] static void stop() {
+    TCCR0B = 0;
+#if defined(TIMSK0)
+    TIMSK0 &= ~_BV(OCIE0A);
+#else
+    TIMSK &= ~_BV(OCIE0A);
+#endif
+  }
+};
+
+}//namespace wake_timer
+
+}//namespace avr::uart
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "avr/uart/common.hpp"
+#include "avr/uart/detail/core.hpp"
 #include "avr/uart/detail/math.hpp"
 #include "avr/uart/detail/inline_asm.hpp"
+#include "avr/uart/sleep_mode.hpp"
 
+#include <avr/interrupt.h>
 #include <avr/io.hpp>
 #if __has_include(<avr/interrupt.hpp>)
 #include <avr/interrupt.hpp>
@@ -11,58 +15,29 @@
 
 namespace avr::uart {
 
-/**
-   [optional] C++14 user defined literals to describe baud rates and
-   clock frequencies.
-
-   Examples:
-   38400_bps
-   576_Kbps
-   1_Mbps
-
-   1_MHz
-   9600_KHz
- */
-inline namespace literals {
-  constexpr uint32_t operator""_bps(unsigned long long v) { return v; }
-  constexpr uint32_t operator""_kbps(unsigned long long v) { return v * 1e3; }
-  constexpr uint32_t operator""_Mbps(unsigned long long v) { return v * 1e6; }
-
-  constexpr uint32_t operator""_Hz(unsigned long long v) { return v; }
-  constexpr uint32_t operator""_kHz(unsigned long long v) { return v * 1e3; }
-  constexpr uint32_t operator""_MHz(unsigned long long v) { return v * 1e6; }
-}//namespace literals
-
-/** CPU required cycles to handle transmission or reception of 1 bit. */
-constexpr auto bit_length_cycles(uint32_t clk, uint32_t baud_rate)
-{ return clk * 1.0/baud_rate; }
+/** consumer of received bytes used by soft::get_stream()
 
-/** buffer to store N received bytes
+    The callable F receives each byte and returns true to keep
+    receiving or false to stop the stream. The number of CPU cycles
+    consumed by F is declared through cycles, and it is checked at
+    compile time against soft::consumer_cycles_budget. F should be
+    inlined, for example:
 
-    This abstraction is used by get<N>() to return the received
-    bytes.
+      consumer<20>([&](uint8_t byte) __attribute__((always_inline)) {
+        sum += byte;
+        return byte != '\n';
+      });
  */
-template<uint8_t N>
-class buffer_t {
-  uint8_t _data[N];
-public:
-  static constexpr uint8_t size{N};
-  
-  using iterator = uint8_t*;
-  using const_iterator = const uint8_t*;
-
-  iterator begin() { return _data; }
-  const_iterator begin() const { return _data; }
-  const_iterator cbegin() const { return _data; }
-  iterator end() { return _data + size; }
-  const_iterator end() const { return _data + size; }
-  const_iterator cend() const { return _data + size; }
-  uint8_t& operator[](uint8_t i) { return _data[i]; }
-  const uint8_t& operator[](uint8_t i) const { return _data[i]; }
-  uint8_t* data() { return _data; }
-  const uint8_t* data() const { return _data; }
+template<uint16_t Cycles, typename F>
+struct consumer_t {
+  static constexpr uint16_t cycles{Cycles};
+  F f;
+  [[gnu::always_inline]] bool operator()(uint8_t byte) { return f(byte); }
 };
 
+template<uint16_t Cycles, typename F>
+constexpr consumer_t<Cycles, F> consumer(F f) { return {f}; }
+
 /**
    Represents a virtual UART device that uses software to transmit and
    receive bytes.
@@ -131,10 +106,6 @@ struct soft {
   static constexpr auto cycles_required{
     detail::math::round(bit_length_cycles(clk, bitrate))};
 
-  static_assert(cycles_required >= 8,
-    "the bit length in cycles must be greater or equal to 8. "\
-    "[clk_frequency/baud_rate >= 8]");
-  
   static_assert(cycles_required <= 513,
     "the bit length in cycles must be less than or equal to 513. "\
     "[clk_frequency/baud_rate <= 513]");
@@ -145,8 +116,57 @@ struct soft {
     TxPin::high();
   }
   
+  /** Indicates if the port of Tx or the pin register of Rx is only
+      reachable by 'lds' and 'sts', for example PORTH..PORTL of the
+      ATmega2560. Only put() and get() support these pins. The bit
+      length must be at least 9 cycles to transmit and 14 cycles to
+      receive, because the start bit is hunted by a loop of 5 cycles
+      and the samples drift up to 0.21 bit from the middle at 14
+      cycles. */
+  static constexpr bool tx_extended_io{TxPin::portx::io_addr() > 0x3f};
+  static constexpr bool rx_extended_io{RxPin::pinx::io_addr() > 0x3f};
+
+  /** Cycles from the falling edge of the start bit to the sample of
+      the first data bit at Phase percent of the bit length. */
+  template<uint8_t Phase>
+  static constexpr double first_sample()
+  { return (1 + Phase / 100.0) * bit_length_cycles(clk, bitrate); }
+
   /** Transmit 1 byte through Tx. */
-  void put(uint8_t byte) const {    
+  void put(uint8_t byte) const {
+    if constexpr (tx_extended_io) put_ext(byte);
+    else put_io(byte);
+  }
+
+  /** put() for a Tx pin in the extended I/O space. */
+  void put_ext(uint8_t byte) const {
+    static_assert(detail::core_timing::extended_io || !tx_extended_io,
+      "this core doesn't have an extended I/O space, use the VPORT "\
+      "registers instead. See avr::uart::vport_pin.");
+
+    static_assert(cycles_required >= 9,
+      "the bit length in cycles must be greater or equal to 9 to use "\
+      "a pin in the extended I/O space. [clk_frequency/baud_rate >= 9]");
+
+    /** loop instructions executed in 9 cycles */
+    constexpr auto delay{cycles_required - 9};
+
+    uint8_t port_value, bits, delay_cnt;
+    asm volatile(AVR_UART_PUT_EXT_ASM_TMPL
+      AVR_UART_PUT_EXT_OUT_OPS
+      AVR_UART_PUT_EXT_IN_OPS
+    );
+  }
+
+  /** put() for a Tx pin in the I/O space. */
+  void put_io(uint8_t byte) const {
+    static_assert(!tx_extended_io,
+      "put_io() requires a Tx pin in the I/O space.");
+
+    static_assert(cycles_required >= 8,
+      "the bit length in cycles must be greater or equal to 8. "\
+      "[clk_frequency/baud_rate >= 8]");
+
     /** loop instructions executed in 8 cycles */
     constexpr auto delay{cycles_required - 8};
       
@@ -194,6 +214,85 @@ struct soft {
     }
   }
 
+  /** [optional] put() without a loop, which allows bit lengths from 3
+      to 16 cycles. Example: 1.6 Mbps @ 8 MHz or 3 Mbps @ 16 MHz.
+
+      Each bit is copied to the port value by 'bst' and 'bld', so the
+      port is written every 3 cycles plus a number of nops computed
+      per bit. The edges follow the fractional bit length instead of
+      the rounded one. The code takes about 30 words plus 1 word per
+      nop.
+   */
+  void put_unrolled(uint8_t byte) const {
+    static_assert(!tx_extended_io,
+      "put_unrolled() requires a Tx pin in the I/O space.");
+
+    static_assert(bit_length_cycles(clk, bitrate) >= 3
+                  && bit_length_cycles(clk, bitrate) <= 16,
+      "the bit length in cycles must be from 3 to 16 to use "\
+      "put_unrolled(). [3 <= clk_frequency/baud_rate <= 16]");
+
+    /** cycle of the edge of the bit i from the start bit */
+    constexpr auto edge = [](uint8_t i)
+    { return detail::math::round(i * bit_length_cycles(clk, bitrate)); };
+
+    /** 'bst', 'bld' and 'out' for the bits 0..7, and 'sbr' and 'out'
+     * for the stop bit, which is kept for 1 bit length. */
+    constexpr uint8_t gaps[]{
+      edge(1) - edge(0) - 3, edge(2) - edge(1) - 3,
+      edge(3) - edge(2) - 3, edge(4) - edge(3) - 3,
+      edge(5) - edge(4) - 3, edge(6) - edge(5) - 3,
+      edge(7) - edge(6) - 3, edge(8) - edge(7) - 3,
+      edge(9) - edge(8) - 2, edge(10) - edge(9) - 1};
+
+    uint8_t port_value;
+    asm volatile(AVR_UART_PUT_UNROLLED_ASM_TMPL
+      AVR_UART_PUT_UNROLLED_OUT_OPS
+      AVR_UART_PUT_UNROLLED_IN_OPS
+    );
+  }
+
+  /** [optional] get() without a loop, which allows bit lengths from 5
+      to 16 cycles. Example: 1.6 Mbps @ 8 MHz or 3 Mbps @ 16 MHz.
+
+      Each bit is sampled by 'sbic' and set by 'ori' in 2 cycles plus
+      a number of nops computed per bit. The start bit is hunted by a
+      loop of 3 cycles, so the samples are shifted by the mean latency
+      of 1.5 cycles, and they stay within +/-1.5 cycles of the middle
+      of the bits. The call returns when the line is high after the
+      last data bit.
+   */
+  uint8_t get_unrolled() const {
+    static_assert(!rx_extended_io,
+      "get_unrolled() requires a Rx pin in the I/O space.");
+
+    static_assert(bit_length_cycles(clk, bitrate) >= 5
+                  && bit_length_cycles(clk, bitrate) <= 16,
+      "the bit length in cycles must be from 5 to 16 to use "\
+      "get_unrolled(). [5 <= clk_frequency/baud_rate <= 16]");
+
+    /** cycle of the sample of the data bit i from the detection of
+     * the start bit */
+    constexpr auto sample = [](uint8_t i) {
+      return detail::math::round(
+        (1.5 + i) * bit_length_cycles(clk, bitrate) - 1.5);
+    };
+
+    /** The detection takes 2 cycles, and each bit takes 2 cycles. */
+    constexpr uint8_t gaps[]{
+      sample(0) - 2, sample(1) - sample(0) - 2,
+      sample(2) - sample(1) - 2, sample(3) - sample(2) - 2,
+      sample(4) - sample(3) - 2, sample(5) - sample(4) - 2,
+      sample(6) - sample(5) - 2, sample(7) - sample(6) - 2};
+
+    uint8_t byte;
+    asm volatile(AVR_UART_GET_UNROLLED_ASM_TMPL
+      AVR_UART_GET_UNROLLED_OUT_OPS
+      AVR_UART_GET_UNROLLED_IN_OPS
+    );
+    return byte;
+  }
+
   /**
      Receive and return 1 byte from Rx. This is a blocking call.
 
@@ -206,15 +305,77 @@ struct soft {
      synchronization between the transmitter and receiver occurs for
      each byte, and between two bytes, the sender can begin sending
      before the receiver waits for the next start bit.
+
+     Phase: sampling point within each bit in percent of the bit
+     length from its beginning. The default is the center of the bit,
+     and a later point can be used for a link with slow rising edges,
+     like an opto-isolated one. See eye_scan().
   */
-  uint8_t get() const {    
+  template<uint8_t Phase = 50>
+  uint8_t get() const {
+    static_assert(Phase > 0 && Phase < 100,
+      "the sampling point must be inside the bit. [0 < Phase < 100]");
+
+    if constexpr (rx_extended_io) return get_ext<Phase>();
+    else return get_io<Phase>();
+  }
+
+  /** get() for a Rx pin in the extended I/O space. */
+  template<uint8_t Phase = 50>
+  uint8_t get_ext() const {
+    static_assert(detail::core_timing::extended_io || !rx_extended_io,
+      "this core doesn't have an extended I/O space, use the VPORT "\
+      "registers instead. See avr::uart::vport_pin.");
+
+    static_assert(cycles_required >= 14,
+      "the bit length in cycles must be greater or equal to 14 to use "\
+      "a Rx pin in the extended I/O space. "\
+      "[clk_frequency/baud_rate >= 14]");
+
+    static_assert(first_sample<Phase>() - 8 < 255.5,
+      "the cycles from the start bit to the first sample minus 8 must "\
+      "be less than 256 cycles. Use a lower Phase or a higher baud "\
+      "rate. [(1 + Phase/100) * clk_frequency/baud_rate - 8 < 255.5]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 6 cycles of instructions before reaching the point of reading
+     * the bit, plus 2 cycles as the mean latency to detect the start
+     * bit with a loop of 5 cycles. */
+    constexpr auto one_half_delay
+      {detail::math::round(first_sample<Phase>() - 8)};
+
+    uint8_t byte{0}, bits, tmp, delay_cnt;
+    asm volatile(AVR_UART_GET_EXT_ASM_TMPL
+      AVR_UART_GET_EXT_OUT_OPS
+      AVR_UART_GET_EXT_IN_OPS
+    );
+    return byte;
+  }
+
+  /** get() for a Rx pin in the I/O space. */
+  template<uint8_t Phase = 50>
+  uint8_t get_io() const {
+    static_assert(!rx_extended_io,
+      "get_io() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 8,
+      "the bit length in cycles must be greater or equal to 8. "\
+      "[clk_frequency/baud_rate >= 8]");
+
+    static_assert(first_sample<Phase>() - 4 < 255.5,
+      "the cycles from the start bit to the first sample minus 4 must "\
+      "be less than 256 cycles. Use a lower Phase or a higher baud "\
+      "rate. [(1 + Phase/100) * clk_frequency/baud_rate - 4 < 255.5]");
+
     /** loop instructions executed in 6 cycles */
     constexpr auto delay{cycles_required - 6};
 
     /** 4(or 3) cycles of instructions before reaching the point of
      * reading the bit. */
     constexpr auto one_half_delay
-      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 4)};
+      {detail::math::round(first_sample<Phase>() - 4)};
 
     uint8_t byte{0}, bits, one_half_delay_cnt,
       one_half_delay_b{one_half_delay / 3};
@@ -310,6 +471,74 @@ struct soft {
     return byte;
   }
 
+  /** [optional] Find the sampling points that receive a known byte
+      without errors, to choose the Phase of get() for a link whose
+      edges are distorted.
+
+      The phase is swept from the beginning to the end of the bit in
+      steps of 3 cycles. Bytes bytes are received at each phase and
+      compared to pattern, and the widest window of consecutive phases
+      without errors is returned in percent of the bit length. The
+      peer must transmit pattern repeatedly with an idle gap of at
+      least 2 frames between two bytes, because each byte is received
+      after an idle line of 1 frame. A pattern like 0x55 has an edge
+      in each bit. This is a blocking call that receives about
+      Bytes * bit length / 3 bytes.
+
+      Example:
+        auto eye = uart.eye_scan(0x55);
+        //eye.from = 38, eye.to = 81: use get<60>()
+   */
+  template<uint8_t Bytes = 8>
+  eye_window eye_scan(uint8_t pattern) const {
+    static_assert(!rx_extended_io,
+      "eye_scan() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 16,
+      "the bit length in cycles must be greater or equal to 16. "\
+      "[clk_frequency/baud_rate >= 16]");
+
+    static_assert(first_sample<100>() - 4 < 765,
+      "the 2 bit length minus 4 cycles must be less than 765 cycles.");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** iterations of 6 cycles during a frame */
+    constexpr uint16_t iterations
+      {uint16_t(10 * bit_length_cycles(clk, bitrate) / 6)};
+
+    /** The first data bit is read 3 * first + 4 cycles after the start
+     * bit. */
+    constexpr double bit{bit_length_cycles(clk, bitrate)};
+    constexpr uint8_t from{uint8_t((bit - 4) / 3 + 1)};
+    constexpr uint8_t to{uint8_t((2 * bit - 4) / 3)};
+    auto phase = [&](uint8_t first)
+      { return uint8_t((3 * first + 4 - bit) * 100 / bit); };
+
+    eye_window eye{};
+    uint8_t begin{0}, width{0}, best{0};
+    for(uint8_t first{from}; first <= to; ++first) {
+      bool ok{true};
+      for(uint8_t i{0}; i < Bytes; ++i) {
+        uint8_t byte, bits, delay_cnt;
+        uint16_t cnt;
+        asm volatile(AVR_UART_GET_PHASE_ASM_TMPL
+          AVR_UART_GET_PHASE_OUT_OPS
+          AVR_UART_GET_PHASE_IN_OPS
+        );
+        if(byte != pattern) ok = false;
+      }
+      if(!ok) { width = 0; continue; }
+      if(width++ == 0) begin = first;
+      if(width > best) {
+        best = width;
+        eye = {phase(begin), phase(first), true};
+      }
+    }
+    return eye;
+  }
+
   /** Receive and return N bytes from Rx. This is a blocking call.
 
       Note: this methods can't handle the high speeds handled by the
@@ -320,6 +549,9 @@ struct soft {
    */
   template<uint8_t N>
   auto get_bytes() const {    
+    static_assert(!rx_extended_io,
+      "get_bytes() requires a Rx pin in the I/O space.");
+
     static_assert(cycles_required >= 16,
                   "the bit length in cycles must be greater or equal to 16. "\
                   "[clk_frequency/baud_rate >= 16]");
@@ -336,8 +568,11 @@ struct soft {
     constexpr auto one_half_delay
       {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 4)};
 
+    /** 8 cycles of instructions plus the 'st' before reaching the
+     * point of reading the first bit of the next byte. */
     constexpr auto one_half_delay_after_fst_bit
-      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 10)};
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 8
+                           - detail::core_timing::st)};
     
     uint8_t byte{0}, bits,
       delay_cnt, delay_b{delay / 3},
@@ -699,6 +934,681 @@ struct soft {
     return buffer;
   }
 
+  /** [optional] Receive 1 byte from Rx checking the start and stop
+      bits. This is a blocking call.
+
+      A start bit that is high at its middle is flagged as a glitch
+      and the next start bit is hunted. A low stop bit is flagged as a
+      framing error, and the call returns when the line is idle
+      again. A line that is already low at the call is flagged as an
+      overrun: the byte in progress began while the application was
+      busy, and it's dropped waiting for the idle line. The bit length
+      must be at least 24 cycles.
+
+      Example:
+        auto r = uart.get_checked();
+        if(r.errors & rx_error::framing) { ... }
+   */
+  rx_result get_checked() const {
+    rx_result r;
+    uint8_t fe{0}, gl{0}, ov{0};
+    receive_checked(&r.byte, 1, fe, gl, ov);
+    r.errors = (fe ? rx_error::framing : 0) | (gl ? rx_error::glitch : 0)
+      | (ov ? rx_error::overrun : 0);
+    return r;
+  }
+
+  /** [optional] get_checked() updating stats. */
+  rx_result get_checked(link_stats& stats) const {
+    auto r = get_checked();
+    ++stats.bytes;
+    if(r.errors & rx_error::framing) ++stats.framing_errors;
+    if(r.errors & rx_error::glitch) ++stats.glitches;
+    if(r.errors & rx_error::overrun) ++stats.overruns;
+    return r;
+  }
+
+  /** [optional] Receive and return N bytes from Rx checking the start
+      and stop bits like get_checked(), and count the errors in
+      stats. This is a blocking call.
+
+      An overrun is counted when the line is already low at the call,
+      which means that the sender started a byte while the application
+      was busy between two calls. The bytes of the sequence are
+      hunted without a gap, so the check is only done at the entry.
+      The bit length must be at least 24 cycles. Example: 230400 bps
+      @ 8 MHz.
+   */
+  template<uint8_t N>
+  auto get_bytes(link_stats& stats) const {
+    buffer_t<N> buffer;
+    uint8_t fe{0}, gl{0}, ov{0};
+    receive_checked(buffer.data(), N, fe, gl, ov);
+    stats.bytes += N;
+    stats.framing_errors += fe;
+    stats.glitches += gl;
+    stats.overruns += ov;
+    return buffer;
+  }
+
+  /** [optional] Receive 1 byte and the value of the timer counter
+      Counter at its start bit. This is a blocking call.
+
+      The counter is read 2 cycles after the sample of the hunt loop
+      that sees the start bit, which is 2 to 5 cycles after the
+      falling edge, so the time of a byte is delayed by the same
+      offset as the other ones. The timer must be started by the
+      application, and its prescaler sets the resolution and the
+      period of wrap-around of the 8-bit counter. See frame_ticks().
+
+      Example:
+        using tcnt0 = timer_counter<0x32>; //ATtiny85
+        TCCR0B = _BV(CS01); //clk/8
+        auto [byte, time] = uart.get_timestamped<tcnt0>();
+   */
+  template<typename Counter>
+  timestamped get_timestamped() const {
+    timestamped r;
+    get_timestamped<Counter>(&r, 1);
+    return r;
+  }
+
+  /** [optional] Receive n bytes storing each one with the value of
+      the timer counter Counter at its start bit, like
+      get_timestamped(). The bytes can be sent in a row.
+
+      The idle gap before a byte is the difference between its time
+      and the time of the previous one minus frame_ticks(). An 8-bit
+      difference is only valid if the gap is shorter than the period
+      of the counter.
+
+      Example:
+        timestamped v[8];
+        uart.get_timestamped<tcnt0>(v, 8);
+        uint8_t gap = v[1].time - v[0].time - uart.frame_ticks(8);
+   */
+  template<typename Counter>
+  void get_timestamped(timestamped* values, uint8_t n) const {
+    static_assert(!rx_extended_io,
+      "get_timestamped() requires a Rx pin in the I/O space.");
+
+    static_assert(Counter::io_addr() <= 0x3f,
+      "the timer counter must be in the I/O space.");
+
+    static_assert(cycles_required >= 16,
+      "the bit length in cycles must be greater or equal to 16. "\
+      "[clk_frequency/baud_rate >= 16]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 5 cycles of instructions, including the read of the counter,
+     * before reaching the point of reading the bit. */
+    constexpr auto one_half_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 5)};
+
+    uint8_t byte, time, bits, delay_cnt;
+    asm volatile(AVR_UART_GET_TIMESTAMPED_ASM_TMPL
+      AVR_UART_GET_TIMESTAMPED_OUT_OPS
+      AVR_UART_GET_TIMESTAMPED_IN_OPS
+    );
+  }
+
+  /** Ticks of a timer with the given prescaler during a frame of 10
+      bits, which is the difference between the times of two bytes
+      sent in a row. */
+  static constexpr uint16_t frame_ticks(uint16_t prescaler)
+  { return 10 * bit_length_cycles(clk, bitrate) / prescaler + 0.5; }
+
+  /** CPU cycles available to a consumer of get_stream() to handle
+      a byte. The consumer is called after the sample of the last
+      data bit, and the stop bit must still be on the line when the
+      receiver comes back, which happens at most 1.5 bit length
+      later. The budget is 1 bit length minus 12 cycles to leave the
+      asm block, to loop and to read the line, which keeps half of a
+      bit as a margin for a sender with a faster clock. */
+  static constexpr int16_t consumer_cycles_budget{
+    int16_t(bit_length_cycles(clk, bitrate)) - 12};
+
+  /** Receive an unbounded sequence of bytes calling consumer for each
+      one of them. This is a blocking call that returns when the
+      consumer returns false.
+
+      There is no buffer: the consumer handles each byte between the
+      last data bit and the next start bit, so the bytes can be sent
+      in a row. The cycles declared by the consumer must not exceed
+      consumer_cycles_budget. See avr::uart::consumer.
+
+      Example:
+        uint8_t sum{0};
+        uart.get_stream(consumer<8>([&](uint8_t byte) {
+          sum += byte;
+          return byte != 0;
+        }));
+   */
+  template<typename Consumer>
+  void get_stream(Consumer consumer) const {
+    static_assert(!rx_extended_io,
+      "get_stream() requires a Rx pin in the I/O space.");
+
+    static_assert(consumer_cycles_budget >= 0,
+      "the bit length is too short to handle a byte between two "\
+      "frames. [clk_frequency/baud_rate >= 12]");
+
+    static_assert(int16_t(Consumer::cycles) <= consumer_cycles_budget,
+      "the consumer takes more CPU cycles than the budget available "\
+      "between two bytes. [Consumer::cycles <= consumer_cycles_budget]");
+
+    static_assert(cycles_required >= 8,
+      "the bit length in cycles must be greater or equal to 8. "\
+      "[clk_frequency/baud_rate >= 8]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 4 cycles of instructions before reaching the point of reading
+     * the bit. */
+    constexpr auto one_half_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 4)};
+
+    uint8_t byte, bits, delay_cnt;
+    do {
+      asm volatile(AVR_UART_GET_STREAM_ASM_TMPL
+        AVR_UART_GET_STREAM_OUT_OPS
+        AVR_UART_GET_STREAM_IN_OPS
+      );
+    } while(consumer(byte));
+  }
+
+  /** Receive up to n bytes from Rx storing them in bytes, and return
+      the number of stored bytes. This is a blocking call.
+
+      The first skip bytes are received and dropped, and the counters
+      have 16 bits, so this version isn't limited to 255 bytes like
+      get_bytes<N>(). The reception stops before n bytes if a stop
+      bit is low, which happens when the sender transmits a break.
+
+      The byte is stored while the stop bit is on the line, so the bit
+      length must be at least 32 cycles. Example: 250 kbps @ 8 MHz.
+   */
+  [[gnu::always_inline]]
+  uint16_t get_bytes(uint8_t* bytes, uint16_t n, uint16_t skip = 0) const {
+    if(n == 0) return 0;
+    return receive_skip<false>(0, bytes, n, skip);
+  }
+
+  /** [optional] get_bytes(bytes, n, skip) after a start code, like a
+      DMX512 packet. This is a blocking call that returns -1 if the
+      first byte isn't code, otherwise it returns the number of stored
+      bytes. The start code is received by the same loop of the bytes,
+      so the first byte after it can follow it in a row.
+   */
+  [[gnu::always_inline]]
+  int16_t get_bytes_after(uint8_t code, uint8_t* bytes, uint16_t n,
+                          uint16_t skip = 0) const
+  {
+    if(n == 0) return 0;
+    return receive_skip<true>(code, bytes, n, skip);
+  }
+
+  /** Receive a frame of bytes delimited by a silence on Rx and return
+      the number of stored bytes. This is a blocking call that waits
+      for the first start bit.
+
+      The start bits after the first one are hunted by a loop of 6
+      cycles that counts the idle time since the last stop bit, and
+      the frame ends when the line stays idle during IdleCycles. Up to
+      max bytes are stored in bytes, the next ones are dropped. The
+      bit length must be at least 24 cycles to store a byte in the
+      half of the stop bit. Example: 115200 bps @ 8 MHz.
+
+      Example:
+        //Modbus RTU: 3.5 characters of 11 bits
+        auto n = uart.get_frame<uint32_t(38.5 * 69)>(buf, sizeof(buf));
+   */
+  template<uint32_t IdleCycles>
+  uint8_t get_frame(uint8_t* bytes, uint8_t max) const {
+    static_assert(!rx_extended_io,
+      "get_frame() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 24,
+      "the bit length in cycles must be greater or equal to 24. "\
+      "[clk_frequency/baud_rate >= 24]");
+
+    /** The idle line is read in a loop of 6 cycles, and the count
+     * starts at the middle of the stop bit. */
+    constexpr uint32_t iterations{
+      (IdleCycles + cycles_required / 2 + 5) / 6};
+
+    static_assert(iterations > 0 && iterations <= 0xffff,
+      "the silence must be counted with 16 bits. "\
+      "[0 < IdleCycles < 393210]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 6 cycles of instructions before reaching the point of reading
+     * the bit, which includes the mean latency to detect the start
+     * bit. */
+    constexpr auto one_half_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 6)};
+
+    uint8_t byte, bits, delay_cnt, room{max};
+    uint16_t cnt;
+    uint8_t* values = bytes;
+    asm volatile(AVR_UART_GET_FRAME_ASM_TMPL
+      AVR_UART_GET_FRAME_OUT_OPS
+      AVR_UART_GET_FRAME_IN_OPS
+    );
+    return values - bytes;
+  }
+
+  /** Transmit a break: a low level on Tx during Bits bit lengths
+      followed by a high level during MarkBits bit lengths. A receiver
+      sees a break as a frame with a low stop bit. Example: the break
+      and the mark after break of DMX512 at 250 kbps are transmitted
+      by send_break<23, 3>(). */
+  template<uint8_t Bits = 13, uint8_t MarkBits = 1>
+  void send_break() const {
+    TxPin::low();
+    __builtin_avr_delay_cycles(uint32_t(Bits) * cycles_required);
+    TxPin::high();
+    __builtin_avr_delay_cycles(uint32_t(MarkBits) * cycles_required);
+  }
+
+  /** Wait for a break: a low level on Rx during at least Bits bit
+      lengths. This is a blocking call that returns at the end of the
+      break, when the line goes high. A low level that ends before is
+      ignored, so the default of 11 bits can't be confused with a
+      frame. */
+  template<uint8_t Bits = 11>
+  void wait_break() const {
+    static_assert(!rx_extended_io,
+      "wait_break() requires a Rx pin in the I/O space.");
+
+    /** The line is read in a loop of 6 cycles. */
+    constexpr uint32_t iterations{
+      (uint32_t(Bits) * cycles_required + 5) / 6};
+
+    static_assert(Bits >= 10,
+      "a break must be longer than the low level of a frame.");
+
+    static_assert(iterations <= 0xffff,
+      "the break is too long to be counted with 16 bits.");
+
+    uint16_t cnt;
+    asm volatile(AVR_UART_WAIT_BREAK_ASM_TMPL
+      AVR_UART_WAIT_BREAK_OUT_OPS
+      AVR_UART_WAIT_BREAK_IN_OPS
+    );
+  }
+
+  /** [optional] Sleep until the start bit of a byte arrives and
+      return the received byte. This is a blocking call.
+
+      The pin change interrupt of Rx wakes up the MCU, and the delay
+      to sample the first data bit is reduced by the wake-up latency
+      of SleepMode. This allows the reception of the first byte sent
+      by a vanilla UART device without any handshaking. The pin
+      change interrupt masks and the global interrupt flag are
+      restored before returning.
+
+      Note: the application must define an empty handler to the pin
+      change interrupt: EMPTY_INTERRUPT(PCINT0_vect); Only Rx pins
+      of the bank PCINT0..7 are supported. See
+      avr::uart::sleep_mode.
+
+      Example:
+        soft<Pb0, Pb1, 9600_bps, 1_MHz> uart;
+        auto cmd = uart.sleep_get(); //sleep_mode::power_down
+   */
+  template<typename SleepMode = sleep_mode::power_down>
+  uint8_t sleep_get() const {
+    static_assert(!rx_extended_io,
+      "sleep_get() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 8,
+      "the bit length in cycles must be greater or equal to 8. "\
+      "[clk_frequency/baud_rate >= 8]");
+
+    /** loop instructions executed in 6 cycles */
+    constexpr auto delay{cycles_required - 6};
+
+    /** 5 cycles of instructions after the wake-up before reaching the
+     * point of reading the bit. */
+    constexpr auto one_half_delay_cycles
+      {1.5 * bit_length_cycles(clk, bitrate) - SleepMode::wake_up_cycles - 5};
+
+    static_assert(one_half_delay_cycles >= 0,
+      "the bit length is too short to wake up from the sleep mode "\
+      "before the first data bit. [1.5 * clk_frequency/baud_rate >= "\
+      "wake_up_cycles + 5]");
+
+    static_assert(one_half_delay_cycles < 255.5,
+      "the 1.5 bit length minus the wake-up latency must be less than "\
+      "256 cycles.");
+
+    constexpr auto one_half_delay{detail::math::round(one_half_delay_cycles)};
+    
+    uint8_t byte{0}, bits, delay_cnt, sreg{SREG};
+    detail::pcint::masks masks;
+
+    detail::pcint::enable<RxPin>();
+    detail::pcint::clear_flag();
+    set_sleep_mode(SleepMode::mode);
+    sleep_enable();
+    asm volatile(AVR_UART_SLEEP_GET_ASM_TMPL
+      AVR_UART_SLEEP_GET_OUT_OPS
+      AVR_UART_SLEEP_GET_IN_OPS
+    );
+    sleep_disable();
+    masks.restore();
+    detail::pcint::clear_flag();
+    SREG = sreg;
+    return byte;
+  }
+
+  /** [optional] Sleep until the start bit of the first byte arrives
+      and receive N bytes. This is a blocking call.
+
+      The first byte is handled like sleep_get(). Between two bytes,
+      the MCU sleeps again if half of the bit length is long enough
+      to store the byte and reach the 'sleep' instruction before the
+      next start bit, and if 1.5 bit length is long enough to wake
+      up(see sleep_between_bytes). Otherwise, the start bit is hunted
+      by busy-polling as get_bytes() does. If the next start bit has
+      already arrived when the MCU would sleep, the byte is received
+      without sleeping. The pin change interrupt masks and the global
+      interrupt flag are restored before returning.
+
+      Note: the application must define an empty handler to the pin
+      change interrupt: EMPTY_INTERRUPT(PCINT0_vect);
+
+      Example:
+        soft<Pb0, Pb1, 9600_bps, 1_MHz> uart;
+        auto cmd = uart.sleep_get_bytes<4, sleep_mode::idle>();
+   */
+  template<uint8_t N, typename SleepMode = sleep_mode::idle>
+  auto sleep_get_bytes() const {
+    static_assert(!rx_extended_io,
+      "sleep_get_bytes() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 16,
+                  "the bit length in cycles must be greater or equal to 16. "\
+                  "[clk_frequency/baud_rate >= 16]");
+
+    buffer_t<N> buffer;
+    uint8_t* pvalues = buffer.data();
+    
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 6 cycles of instructions after the wake-up before reaching the
+     * point of reading the bit. */
+    constexpr auto one_half_delay_cycles
+      {1.5 * bit_length_cycles(clk, bitrate) - SleepMode::wake_up_cycles - 6};
+
+    static_assert(one_half_delay_cycles >= 0,
+      "the bit length is too short to wake up from the sleep mode "\
+      "before the first data bit. [1.5 * clk_frequency/baud_rate >= "\
+      "wake_up_cycles + 6]");
+
+    static_assert(one_half_delay_cycles < 255.5,
+      "the 1.5 bit length minus the wake-up latency must be less than "\
+      "256 cycles.");
+    
+    constexpr auto one_half_delay{detail::math::round(one_half_delay_cycles)};
+
+    /** 5 cycles of instructions after the detection of the start bit
+     * by busy-polling. */
+    constexpr auto busy_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 5)};
+
+    /** 6 cycles of instructions after the detection of a start bit
+     * that arrived before sleeping. */
+    constexpr auto late_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 6)};
+
+    constexpr bool sleep_between{
+      sleep_between_bytes<SleepMode>};
+
+    uint8_t byte{0}, bits, delay_cnt, cnt, sreg{SREG};
+    detail::pcint::masks masks;
+
+    detail::pcint::enable<RxPin>();
+    set_sleep_mode(SleepMode::mode);
+    sleep_enable();
+    asm volatile(AVR_UART_SLEEP_GET_SEQ_ASM_TMPL
+      AVR_UART_SLEEP_GET_SEQ_OUT_OPS
+      AVR_UART_SLEEP_GET_SEQ_IN_OPS
+    );
+    sleep_disable();
+    masks.restore();
+    detail::pcint::clear_flag();
+    SREG = sreg;
+    return buffer;
+  }
+
+  /** Indicates if sleep_get_bytes() sleeps between two bytes using
+      SleepMode. The instructions executed from the sample of the stop
+      bit until the 'sleep' take 14 cycles, and they must fit in half
+      of the bit length. */
+  template<typename SleepMode>
+  static constexpr bool sleep_between_bytes{
+    0.5 * bit_length_cycles(clk, bitrate) >= 14
+    && 1.5 * bit_length_cycles(clk, bitrate) >= SleepMode::wake_up_cycles + 6};
+
+  /** [optional] Transmit 1 byte in a frame of 9 data bits, where the
+      9th bit is set when address is true. This is the multi-drop
+      scheme of the MPCM mode of the hardware USART: the master
+      transmits the address of a node with the 9th bit set followed by
+      the data bytes to that node with the 9th bit cleared. The bit
+      length must be at least 9 cycles. See get_addressed().
+
+      Example:
+        uart.put9(node, true);
+        uart.put9(cmd, false);
+        uart.put9(arg, false);
+   */
+  void put9(uint8_t byte, bool address) const {
+    static_assert(!tx_extended_io,
+      "put9() requires a Tx pin in the I/O space.");
+
+    static_assert(cycles_required >= 9,
+      "the bit length in cycles must be greater or equal to 9. "\
+      "[clk_frequency/baud_rate >= 9]");
+
+    /** loop instructions executed in 9 cycles */
+    constexpr auto delay{cycles_required - 9};
+
+    /** start bit, data bits, address bit and stop bit from the LSB */
+    uint16_t frame = (0x200 | (address ? 0x100 : 0) | byte) << 1;
+    uint8_t port_value, bits, delay_cnt;
+    asm volatile(AVR_UART_PUT9_ASM_TMPL
+      AVR_UART_PUT9_OUT_OPS
+      AVR_UART_PUT9_IN_OPS
+    );
+  }
+
+  /** [optional] Receive N data bytes addressed to this node in frames
+      of 9 data bits transmitted by put9(). This is a blocking call.
+
+      The node is selected by an address byte equal to address and it
+      is deselected by any other address byte. The data bytes received
+      while the node isn't selected are dropped by the receive loop
+      without leaving it, so the frames to the other nodes only cost
+      the sampling of the bits. The bit length must be at least 16
+      cycles.
+
+      Example:
+        soft<Pb0, Pb1, 115200_bps, 8_MHz> uart;
+        auto cmd = uart.get_addressed<2>(0x12);
+   */
+  template<uint8_t N>
+  auto get_addressed(uint8_t address) const
+  { return receive_addressed<N, false, sleep_mode::idle, 0, void>(address); }
+
+  /** [optional] get_addressed() sleeping with SleepMode until the
+      start bit of a frame arrives while the node isn't selected. The
+      start bits of the frames to the node are hunted by busy-polling.
+      The start bit is read again after the wake-up, so the bit length
+      must be at least the wake-up latency of SleepMode plus 4
+      cycles. The pin change interrupt masks and the global interrupt
+      flag are restored before returning.
+
+      When Skip is zero, the node wakes up at each start bit and it
+      samples all the frames to the other nodes, so it only sleeps in
+      the idle gaps between the frames.
+
+      When Skip isn't zero, each address byte is followed by exactly
+      Skip data bytes, and the node sleeps through the data frames to
+      the other nodes without sampling them. The start bit of each
+      skipped frame wakes up the CPU, and Timer wakes it up again in
+      the 9th bit, which is low in a data frame, with the pin change
+      interrupt disabled in between. The end of the frame is the
+      rising edge of the stop bit. The node samples only the address
+      frames and its own data frames, so the CPU time and the energy
+      spent on the traffic of the other nodes drop with the number of
+      data bytes per address. The idle mode is used to skip the
+      frames because the timer must run.
+
+      Note: the application must define an empty handler to the pin
+      change interrupt: EMPTY_INTERRUPT(PCINT0_vect); See
+      sleep_get(). When Skip isn't zero, it must define the handler
+      required by Timer. See wake_timer::timer0.
+
+      Example:
+        auto cmd = uart.sleep_get_addressed<2>(0x12); //sleep_mode::idle
+
+        //each address is followed by 2 data bytes on the bus
+        auto cmd = uart.sleep_get_addressed<2, sleep_mode::idle, 2>(0x12);
+   */
+  template<uint8_t N, typename SleepMode = sleep_mode::idle,
+           uint8_t Skip = 0, typename Timer = wake_timer::timer0<>>
+  auto sleep_get_addressed(uint8_t address) const {
+    uint8_t sreg{SREG};
+    detail::pcint::masks masks;
+    detail::pcint::enable<RxPin>();
+    detail::pcint::clear_flag();
+    set_sleep_mode(SleepMode::mode);
+    sleep_enable();
+    auto buffer = receive_addressed<N, true, SleepMode, Skip, Timer>(address);
+    sleep_disable();
+    masks.restore();
+    detail::pcint::clear_flag();
+    SREG = sreg;
+    return buffer;
+  }
+
+  /** Minimum bit length in cycles supported by transfer() and
+      transfer_bytes(). Each quarter of a bit must fit a read of the
+      Rx line and a control block of 14 cycles. Examples: 8600 bps @
+      1 MHz, 9600 bps @ 1.2 MHz and 64 kbps @ 8 MHz. */
+  static constexpr uint8_t transfer_min_cycles{116};
+
+  /** [optional] Transmit 1 byte through Tx while 1 byte is received
+      from Rx, and return the received byte. This is a blocking call
+      that returns after the stop bit was transmitted and the byte
+      was received.
+
+      Both lines are handled by the same loop, so the frame received
+      doesn't need to be aligned with the frame transmitted. The Rx
+      line is read four times per bit, which means that a data bit
+      can be sampled up to a quarter of the bit length away from its
+      middle.
+   */
+  uint8_t transfer(uint8_t byte) const
+  { return transfer_bytes<1>(&byte)[0]; }
+
+  /** [optional] Transmit N bytes from bytes in a row through Tx while
+      N bytes are received from Rx. This is a blocking call. See
+      transfer().
+
+      Example:
+        soft<Pb0, Pb1, 9600_bps, 1200_kHz> uart;
+        const uint8_t req[]{0x01, 0x02};
+        auto res = uart.transfer_bytes<2>(req);
+   */
+  template<uint8_t N>
+  auto transfer_bytes(const uint8_t* bytes) const {
+    static_assert(!tx_extended_io && !rx_extended_io,
+      "transfer_bytes() requires Tx and Rx pins in the I/O space.");
+
+    static_assert(N > 0);
+    static_assert(cycles_required >= transfer_min_cycles,
+      "the bit length in cycles must be greater or equal to 116 to "\
+      "transmit and receive at the same time. "\
+      "[clk_frequency/baud_rate >= 116]");
+
+    /** The Rx line is read at the beginning of each quarter of a
+     * bit. The fixed cycles of each quarter are: 15 to read the line
+     * and 14 to handle Tx, 15 and 14 to handle Rx, 15 and 14 to loop
+     * and to set Tx. */
+    constexpr auto q1{detail::math::round(cycles_required / 4.0)};
+    constexpr auto q2{detail::math::round(cycles_required / 2.0)};
+    constexpr auto q3{detail::math::round(cycles_required * 3 / 4.0)};
+    constexpr auto d0{q1 - 15};
+    constexpr auto d1{q2 - q1 - 29};
+    constexpr auto d2{q3 - q2 - 29};
+    constexpr auto d3{cycles_required - q3 - 29};
+
+    buffer_t<N> buffer;
+    uint8_t* dst = buffer.data();
+    const uint8_t* src = bytes;
+    uint8_t port_value, tx, n, rx, s, rt, tmp, dly, txc{N - 1}, rxc{N};
+    asm volatile(AVR_UART_TRANSFER_ASM_TMPL
+      AVR_UART_TRANSFER_OUT_OPS
+      AVR_UART_TRANSFER_IN_OPS
+    );
+    return buffer;
+  }
+
+  /** [optional] Repeat 1 byte from Rx to Tx bit by bit and return the
+      received byte. This is a blocking call.
+
+      Each bit is driven on Tx right after its sample in the middle of
+      the bit, so the frame is regenerated with a latency of half of
+      the bit length instead of a whole frame. When decrement is true,
+      the transmitted byte is the received byte minus 1, which can be
+      used to update a hop counter in flight. The stop bit is always
+      transmitted as a high level.
+
+      Note: like get(), the sender can start the next byte before the
+      receiver is waiting for its start bit if the application takes
+      more than half of the bit length between two calls.
+
+      Example:
+        //daisy chain: the first byte is the hop counter
+        auto hops = uart.repeat(true);
+   */
+  uint8_t repeat(bool decrement = false) const {
+    static_assert(!tx_extended_io && !rx_extended_io,
+      "repeat() requires Tx and Rx pins in the I/O space.");
+
+    static_assert(cycles_required >= 14,
+      "the bit length in cycles must be greater or equal to 14 to "\
+      "repeat a byte. [clk_frequency/baud_rate >= 14]");
+
+    /** 2 cycles of instructions after the detection of the start
+     * bit. */
+    constexpr auto half_delay
+      {detail::math::round(0.5 * bit_length_cycles(clk, bitrate) - 2)};
+
+    /** 6 cycles of instructions after the check of the start bit. */
+    constexpr auto fst_delay{cycles_required - 6};
+
+    /** loop instructions executed in 14 cycles */
+    constexpr auto delay{cycles_required - 14};
+
+    uint8_t byte, port_value, bits, tmp, delay_cnt,
+      borrow(decrement ? RxPin::bv() : 0);
+    asm volatile(AVR_UART_REPEAT_ASM_TMPL
+      AVR_UART_REPEAT_OUT_OPS
+      AVR_UART_REPEAT_IN_OPS
+    );
+    return byte;
+  }
+
   /** [optional] This is a handshaking method that utilizes the Tx/Rx
       lines to ensure that the receiver can receive the data sent by
       the trasmitter. This method is used by the transmitter , and
@@ -711,6 +1621,9 @@ struct soft {
       can follow the handshaking.
   */
   [[gnu::always_inline]] inline void request_to_send() const {
+    static_assert(!tx_extended_io && !rx_extended_io,
+      "request_to_send() requires Tx and Rx pins in the I/O space.");
+
     asm volatile(
     R"(
       cbi  %[portx], %[tx_pin]
@@ -776,6 +1689,164 @@ struct soft {
     }
   }
 #endif
+private:
+  /** Receive the data bytes addressed to address. See
+      AVR_UART_GET_ADDRESSED_ASM_TMPL. */
+  template<uint8_t N, bool Sleep, typename SleepMode, uint8_t Skip,
+           typename Timer>
+  auto receive_addressed(uint8_t address) const {
+    static_assert(!rx_extended_io,
+      "get_addressed() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 16,
+      "the bit length in cycles must be greater or equal to 16. "\
+      "[clk_frequency/baud_rate >= 16]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 4 cycles of instructions after the detection of the start bit
+     * by busy-polling. */
+    constexpr auto one_half_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 4)};
+
+    /** 7 cycles of instructions after the wake-up before reaching the
+     * point of reading the bit. */
+    constexpr auto sleep_delay_cycles
+      {1.5 * bit_length_cycles(clk, bitrate) - SleepMode::wake_up_cycles - 7};
+
+    /** The start bit is read again after the wake-up to drop the
+     * wake-ups caused by other edges, so it must be still there. */
+    static_assert(!Sleep
+      || bit_length_cycles(clk, bitrate) >= SleepMode::wake_up_cycles + 4,
+      "the bit length is too short to read the start bit after the "\
+      "wake-up from the sleep mode. [clk_frequency/baud_rate >= "\
+      "wake_up_cycles + 4]");
+
+    static_assert(1.5 * bit_length_cycles(clk, bitrate) - 4 < 255.5,
+      "the 1.5 bit length minus 4 cycles must be less than 256 "\
+      "cycles.");
+
+    constexpr uint8_t sleep{Sleep};
+    constexpr uint8_t sleep_delay
+      {Sleep ? detail::math::round(sleep_delay_cycles) : 0};
+    constexpr uint8_t skip{Skip > 0};
+
+    buffer_t<N> buffer;
+    uint8_t* values = buffer.data();
+    uint8_t n{N}, byte, bits, delay_cnt, selected;
+    while(true) {
+      asm volatile(AVR_UART_GET_ADDRESSED_ASM_TMPL
+        AVR_UART_GET_ADDRESSED_OUT_OPS
+        AVR_UART_GET_ADDRESSED_IN_OPS
+      );
+      if constexpr(Skip > 0) {
+        if(n > 0) {
+          skip_frames<Skip, SleepMode, Timer>();
+          continue;
+        }
+      }
+      return buffer;
+    }
+  }
+
+  /** Receive bytes by AVR_UART_GET_SKIP_ASM_TMPL, which checks the
+      start code when Check is true. */
+  template<bool Check>
+  [[gnu::always_inline]]
+  int16_t receive_skip(uint8_t code, uint8_t* bytes, uint16_t n,
+                       uint16_t skip) const {
+    static_assert(!rx_extended_io,
+      "get_bytes() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 32,
+      "the bit length in cycles must be greater or equal to 32. "\
+      "[clk_frequency/baud_rate >= 32]");
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    /** 4 cycles of instructions before reaching the point of reading
+     * the bit. */
+    constexpr auto one_half_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate) - 4)};
+
+    uint8_t byte, bits, delay_cnt, started{0};
+    uint8_t* values = bytes;
+    asm volatile(AVR_UART_GET_SKIP_ASM_TMPL
+      AVR_UART_GET_SKIP_OUT_OPS
+      AVR_UART_GET_SKIP_IN_OPS
+    );
+    if(Check && !started) return -1;
+    return values - bytes;
+  }
+
+  /** Skip Skip data frames of 9 bits sleeping in the idle mode. The
+      start bit of each frame wakes up the CPU through the pin change
+      interrupt, and Timer wakes it up at about 9.5 bit lengths after
+      the start bit, in the 9th bit. Each wake-up is estimated as the
+      latency of sleep_mode::idle, plus 10 cycles of instructions and
+      half of a tick as the mean phase of the prescaler. */
+  template<uint8_t Skip, typename SleepMode, typename Timer>
+  static void skip_frames() {
+    constexpr auto ticks{
+      (9.5 * bit_length_cycles(clk, bitrate)
+       - 2 * sleep_mode::idle::wake_up_cycles - 10) / Timer::prescaler
+      - 0.5};
+
+    static_assert(Timer::prescaler <= bit_length_cycles(clk, bitrate) / 4,
+      "a tick of the timer must be at most a quarter of the bit "\
+      "length. [prescaler <= clk_frequency/baud_rate/4]");
+
+    static_assert(ticks >= 1 && ticks < 255.5,
+      "the prescaler of the timer doesn't fit 9.5 bit lengths in 1 "\
+      "to 255 ticks.");
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    for(uint8_t i{Skip}; i > 0; --i) {
+      detail::pcint::clear_flag();
+      while(RxPin::is_high()) { sei(); sleep_cpu(); cli(); }
+      Timer::start(uint8_t(ticks + 0.5));
+      detail::pcint::disable<RxPin>();
+      while(!Timer::expired()) { sei(); sleep_cpu(); cli(); }
+      Timer::stop();
+      while(RxPin::is_low());
+      detail::pcint::enable<RxPin>();
+    }
+    set_sleep_mode(SleepMode::mode);
+  }
+
+  /** Receive n bytes checking the start and stop bits. The errors are
+      counted by fe, gl and ov. See AVR_UART_GET_CHECKED_ASM_TMPL. */
+  void receive_checked(uint8_t* values, uint8_t n,
+                       uint8_t& fe, uint8_t& gl, uint8_t& ov) const {
+    static_assert(!rx_extended_io,
+      "get_checked() requires a Rx pin in the I/O space.");
+
+    static_assert(cycles_required >= 24,
+      "the bit length in cycles must be greater or equal to 24. "\
+      "[clk_frequency/baud_rate >= 24]");
+
+    /** 2 cycles of instructions after the detection of the start
+     * bit. */
+    constexpr auto half_delay
+      {detail::math::round(0.5 * bit_length_cycles(clk, bitrate)) - 2};
+
+    /** 4 cycles of instructions between the check of the start bit
+     * and the sample of the first data bit. */
+    constexpr auto fst_delay
+      {detail::math::round(1.5 * bit_length_cycles(clk, bitrate))
+       - detail::math::round(0.5 * bit_length_cycles(clk, bitrate)) - 4};
+
+    /** loop instructions executed in 8 cycles */
+    constexpr auto delay{cycles_required - 8};
+
+    uint8_t byte, bits, delay_cnt;
+    asm volatile(AVR_UART_GET_CHECKED_ASM_TMPL
+      AVR_UART_GET_CHECKED_OUT_OPS
+      AVR_UART_GET_CHECKED_IN_OPS
+    );
+  }
 };
 
 } //namespace avr::uart
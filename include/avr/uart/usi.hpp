@@ -0,0 +1,338 @@
+#pragma once
+
+#include "avr/uart/detail/math.hpp"
+#include "avr/uart/ring_buffer.hpp"
+#include "avr/uart/soft.hpp"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+#if !defined(USIBR)
+#error "avrUART: avr::uart::usi requires an USI with the buffer register USIBR (ATtiny25/45/85)"
+#endif
+
+/** Defines the handlers of the USI counter overflow interrupt, used
+    by usi::put() to load the second half of a frame and by the
+    reception to store a byte, and of the pin change interrupt, which
+    starts the reception at the start bit. It must be used once by the
+    application, for example:
+
+      using uart_t = avr::uart::usi<115200_bps, 8_MHz>;
+      AVR_UART_USI_ISR(uart_t);
+ */
+#define AVR_UART_USI_ISR(Usi)                                   \
+  ISR(USI_OVF_vect) { Usi::on_usi_overflow(); }                 \
+  ISR(PCINT0_vect, ISR_NAKED) { Usi::on_start_bit(); }
+
+namespace avr::uart {
+
+namespace detail {
+
+/** Reverse the order of the bits of byte. The USI shifts the MSB
+    first and the UART frame carries the LSB first. */
+[[gnu::always_inline]] inline uint8_t reverse(uint8_t byte) {
+  byte = (byte >> 4) | (byte << 4);
+  byte = ((byte & 0xcc) >> 2) | ((byte & 0x33) << 2);
+  return ((byte & 0xaa) >> 1) | ((byte & 0x55) << 1);
+}
+
+}//namespace detail
+
+/**
+   Represents an UART device that uses the USI and the Timer/Counter0
+   to transmit and receive bytes. It has the same interface of
+   avr::uart::soft.
+
+   The USI shifts the bits clocked by the compare match of the
+   Timer/Counter0, so the CPU doesn't count cycles:
+
+   - put() loads the first half of the frame and returns. The second
+     half is loaded by the USI overflow interrupt, so the application
+     runs while the byte is transmitted.
+
+   - listen() starts the reception in the background. The falling
+     edge of the start bit raises the pin change interrupt of DI,
+     whose handler starts the timer, and the bits are sampled by the
+     USI. The USI overflow interrupt stores the byte in a ring buffer
+     of RxSize bytes, so the application runs while each byte is
+     received. available() returns the number of bytes in the buffer,
+     and get() and get_bytes() read them waiting for them if needed.
+
+   The interrupt handlers must be defined by the application using
+   AVR_UART_USI_ISR(), and the global interrupt flag must be set. The
+   start of the timer is compensated by the fixed latency of the pin
+   change interrupt, so the start bit is detected late by any handler
+   or block with the interrupts disabled that is running when it
+   comes. That delay must not exceed a quarter of the bit length.
+
+   The pins are fixed by the USI: Rx is DI(PB0) and Tx is DO(PB1). The
+   communication is half-duplex: DO is an input pin with the pull-up
+   while the device listens, the reception is paused while a byte is
+   transmitted, and put() waits for the end of a byte being received.
+   The Timer/Counter0 and the pin change interrupt PCINT0 can't be
+   used by the application.
+
+   A soft device can be used on other pins, but its methods count
+   cycles, so flush() must be called before them to finish a pending
+   transmission, and the reception must be stopped by
+   stop_listening().
+
+   Arguments:
+
+   baud_rate: unsigned value describing the baud rate speed. The bit
+              length must be at least 64 cycles to serve the overflow
+              interrupt before the next bit. Example: 115200 bps @ 8
+              MHz.
+
+   clk_cpu: unsigned value describing CPU clock frequency. The F_CPU
+            macro's value will be used by default if it is defined.
+
+   RxSize: size of the ring buffer of the received bytes, it must be a
+           power of two.
+ */
+#ifdef F_CPU
+template<uint32_t baud_rate, uint32_t clk_cpu = F_CPU, uint8_t RxSize = 16>
+#else
+template<uint32_t baud_rate, uint32_t clk_cpu, uint8_t RxSize = 16>
+#endif
+struct usi {
+  static constexpr uint32_t bitrate = baud_rate;
+  static constexpr uint32_t clk = clk_cpu;
+
+  static_assert(bit_length_cycles(clk, bitrate) >= 64,
+    "the bit length in cycles must be greater or equal to 64. "\
+    "[clk_frequency/baud_rate >= 64]");
+
+  static_assert(bit_length_cycles(clk, bitrate) <= 2040,
+    "the bit length in cycles must be less than or equal to 2040. "\
+    "[clk_frequency/baud_rate <= 2040]");
+
+  /** Prescaler of the Timer/Counter0 */
+  static constexpr uint8_t prescaler{
+    bit_length_cycles(clk, bitrate) < 255.5 ? 1 : 8};
+
+  /** Rounded timer ticks of a bit. */
+  static constexpr uint8_t bit_ticks{
+    detail::math::round(bit_length_cycles(clk, bitrate) / prescaler)};
+
+  /** Cycles from the falling edge of the start bit until the timer
+      starts: 3 to set the pin change flag, 1.5 as the mean to finish
+      the current instruction, 4 to respond to the interrupt, 2 of
+      the jump in the vector and 10 of instructions in the handler. */
+  static constexpr double rx_start_cycles{3 + 1.5 + 4 + 2 + 10};
+
+  /** Initial count of the timer after the detection of a start
+      bit. The first compare match samples the start bit at its
+      middle. */
+  static constexpr uint8_t rx_start_count{
+    bit_ticks - detail::math::round(
+      (0.5 * bit_length_cycles(clk, bitrate) - rx_start_cycles)
+      / prescaler)};
+
+  /** Set up the DO pin as an output pin with a high level and the
+      USI in three-wire mode without a clock source. */
+  usi() {
+    PORTB |= _BV(PB0) | _BV(PB1);
+    USIDR = 0xff;
+    USICR = _BV(USIWM0);
+    DDRB |= _BV(PB1);
+    TCCR0A = _BV(WGM01);
+    OCR0A = bit_ticks - 1;
+  }
+
+  /** Transmit 1 byte through DO. This call returns after the first
+      half of the frame is loaded, and it waits for the end of a
+      pending transmission or reception. */
+  void put(uint8_t byte) const {
+    uint8_t sreg{SREG};
+    while(true) {
+      flush();
+      cli();
+      if(_state == state::idle) break;
+      SREG = sreg;
+    }
+    pause_rx();
+    auto bits = detail::reverse(byte);
+    /** stop bit and idle level */
+    _second_half = (bits << 4) | 0x0f;
+    _state = state::first_half;
+    start_timer(0);
+    /** start bit and the data bits 0..6, the data bit 4 is the level
+     * of DO when the counter overflows. */
+    USIDR = bits >> 1;
+    USISR = _BV(USIOIF) | (16 - 5);
+    USICR = _BV(USIOIE) | _BV(USIWM0) | _BV(USICS0);
+    SREG = sreg;
+  }
+
+  /** Start the reception in the background. The bytes received before
+      the call are lost. */
+  void listen() const {
+    uint8_t sreg{SREG};
+    cli();
+    _listening = true;
+    if(_state == state::idle) resume_rx();
+    SREG = sreg;
+  }
+
+  /** Stop the reception after a byte being received. The bytes in the
+      buffer are kept. */
+  void stop_listening() const {
+    uint8_t sreg{SREG};
+    _listening = false;
+    while(true) {
+      flush();
+      cli();
+      if(_state == state::idle) break;
+      SREG = sreg;
+    }
+    pause_rx();
+    SREG = sreg;
+  }
+
+  /** Number of received bytes in the buffer. */
+  uint8_t available() const {
+    asm volatile("" ::: "memory");
+    return _rx.size();
+  }
+
+  /** Number of bytes lost because the buffer was full. */
+  uint8_t overflows() const {
+    asm volatile("" ::: "memory");
+    return _overflows;
+  }
+
+  /** Read and return 1 received byte. This is a blocking call that
+      starts the reception if the device isn't listening. */
+  uint8_t get() const {
+    if(!_listening) listen();
+    while(available() == 0);
+    uint8_t sreg{SREG};
+    cli();
+    auto byte = _rx.pop();
+    SREG = sreg;
+    return byte;
+  }
+
+  /** Read and return N received bytes. This is a blocking call. See
+      get(). */
+  template<uint8_t N>
+  auto get_bytes() const {
+    buffer_t<N> buffer;
+    for(auto& byte : buffer) byte = get();
+    return buffer;
+  }
+
+  /** Wait for the end of a pending transmission or of a byte being
+      received. */
+  void flush() const { while(_state != state::idle); }
+
+  /** Handler of the USI counter overflow interrupt. See
+      AVR_UART_USI_ISR. */
+  [[gnu::always_inline]] static void on_usi_overflow() {
+    if(_state == state::receiving) {
+      uint8_t byte = USIBR;
+      USICR = _BV(USIWM0);
+      USISR = _BV(USIOIF);
+      TCCR0B = 0;
+      resume_rx();
+      _state = state::idle;
+      if(!_rx.push(detail::reverse(byte))) ++_overflows;
+    } else if(_state == state::first_half) {
+      USIDR = _second_half;
+      USISR = _BV(USIOIF) | (16 - 5);
+      _state = state::second_half;
+    } else {
+      USICR = _BV(USIWM0);
+      USISR = _BV(USIOIF);
+      USIDR = 0xff;
+      TCCR0B = 0;
+      if(_listening) resume_rx();
+      _state = state::idle;
+    }
+  }
+
+  /** Naked handler of the pin change interrupt of DI. A falling edge
+      starts the timer and the USI to sample the start bit and the
+      data bits, and it disables the pin change interrupt until the
+      end of the byte. The other edges are dropped. See
+      AVR_UART_USI_ISR. */
+  [[gnu::always_inline]] static void on_start_bit() {
+    asm volatile(
+      "  sbic %[pinb], %[di]                  \n\t"
+      "  reti                                 \n\t"
+      "  push r16                             \n\t"
+      "  ldi  r16, %[psr0]                    \n\t"
+      "  out  %[gtccr], r16                   \n\t"
+      "  ldi  r16, %[count]                   \n\t"
+      "  out  %[tcnt0], r16                   \n\t"
+      "  ldi  r16, %[cs]                      \n\t"
+      "  out  %[tccr0b], r16                  \n\t"
+      "  ldi  r16, %[usisr]                   \n\t"
+      "  out  %[usisr_addr], r16              \n\t"
+      "  ldi  r16, %[usicr]                   \n\t"
+      "  out  %[usicr_addr], r16              \n\t"
+      "  cbi  %[pcmsk], %[pcint]              \n\t"
+      "  ldi  r16, %[receiving]               \n\t"
+      "  sts  %[state], r16                   \n\t"
+      "  pop  r16                             \n\t"
+      "  reti                                 \n\t"
+      :
+      : [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [di] "I" (PB0),
+        [psr0] "M" (_BV(PSR0)),
+        [gtccr] "I" (_SFR_IO_ADDR(GTCCR)),
+        [count] "M" (rx_start_count),
+        [tcnt0] "I" (_SFR_IO_ADDR(TCNT0)),
+        [cs] "M" (prescaler == 1 ? _BV(CS00) : _BV(CS01)),
+        [tccr0b] "I" (_SFR_IO_ADDR(TCCR0B)),
+        [usisr] "M" (_BV(USIOIF) | (16 - 9)),
+        [usisr_addr] "I" (_SFR_IO_ADDR(USISR)),
+        [usicr] "M" (_BV(USIOIE) | _BV(USIWM0) | _BV(USICS0)),
+        [usicr_addr] "I" (_SFR_IO_ADDR(USICR)),
+        [pcmsk] "I" (_SFR_IO_ADDR(PCMSK)),
+        [pcint] "I" (PCINT0),
+        [receiving] "M" (uint8_t(state::receiving)),
+        [state] "i" (&_state)
+    );
+  }
+private:
+  enum class state : uint8_t { idle, first_half, second_half, receiving };
+
+  static inline volatile state _state{state::idle};
+  static inline volatile uint8_t _second_half;
+  static inline volatile bool _listening{false};
+  static inline ring_buffer<RxSize> _rx;
+  static inline uint8_t _overflows{0};
+
+  [[gnu::always_inline]] static void start_timer(uint8_t count) {
+    GTCCR = _BV(PSR0);
+    TCNT0 = count;
+    TCCR0B = prescaler == 1 ? _BV(CS00) : _BV(CS01);
+  }
+
+  /** DO as an input pin with the pull-up and the pin change interrupt
+      of DI enabled. A pending flag is cleared, so only the edges after
+      this call are seen. */
+  [[gnu::always_inline]] static void resume_rx() {
+    DDRB &= ~_BV(PB1);
+    GIFR = _BV(PCIF);
+    PCMSK |= _BV(PCINT0);
+    GIMSK |= _BV(PCIE);
+  }
+
+  /** DO as an output pin with a high level and the pin change
+      interrupt of DI disabled. A flag raised by an edge before the
+      mask is cleared too, otherwise on_start_bit() would run in the
+      middle of the transmission when the interrupts are enabled
+      again. */
+  [[gnu::always_inline]] static void pause_rx() {
+    PCMSK &= ~_BV(PCINT0);
+    GIFR = _BV(PCIF);
+    USIDR = 0xff;
+    DDRB |= _BV(PB1);
+  }
+};
+
+}//namespace avr::uart
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <avr/io.h>
+#include <stdint.h>
+
+namespace avr::uart {
+
+/**
+   Pin of an AVRxt core(tinyAVR 0/1/2-series, megaAVR 0-series)
+   reached through the virtual port VPORTx, which maps the registers
+   DIR, OUT and IN of a port in the I/O space. It provides the
+   interface of an avrIO pin required by avr::uart::soft, so the
+   cycle-exact 'in', 'out', 'sbic' and 'sbis' can be used.
+
+   Port: index of the port, 0 for PORTA, 1 for PORTB, and so on.
+
+   Example:
+     soft<vport::pa<6>, vport::pa<7>, 2500_kbps, 20_MHz> uart;
+ */
+template<uint8_t Port, uint8_t Bit>
+struct vport_pin {
+  struct ddrx { static constexpr uint8_t io_addr() { return Port * 4; } };
+  struct portx { static constexpr uint8_t io_addr() { return Port * 4 + 1; } };
+  struct pinx { static constexpr uint8_t io_addr() { return Port * 4 + 2; } };
+
+  static constexpr uint8_t value{Bit};
+  static constexpr uint8_t bv() { return 1 << Bit; }
+
+  [[gnu::always_inline]] static void out() { reg(ddrx::io_addr()) |= bv(); }
+  [[gnu::always_inline]] static void in() { reg(ddrx::io_addr()) &= ~bv(); }
+  [[gnu::always_inline]] static void high() { reg(portx::io_addr()) |= bv(); }
+  [[gnu::always_inline]] static void low() { reg(portx::io_addr()) &= ~bv(); }
+  [[gnu::always_inline]] static bool is_high() { return reg(pinx::io_addr()) & bv(); }
+  [[gnu::always_inline]] static bool is_low() { return !is_high(); }
+private:
+  [[gnu::always_inline]] static volatile uint8_t& reg(uint8_t io_addr)
+  { return _SFR_IO8(io_addr); }
+};
+
+namespace vport {
+template<uint8_t Bit> using pa = vport_pin<0, Bit>;
+template<uint8_t Bit> using pb = vport_pin<1, Bit>;
+template<uint8_t Bit> using pc = vport_pin<2, Bit>;
+template<uint8_t Bit> using pd = vport_pin<3, Bit>;
+template<uint8_t Bit> using pe = vport_pin<4, Bit>;
+template<uint8_t Bit> using pf = vport_pin<5, Bit>;
+}//namespace vport
+
+}//namespace avr::uart
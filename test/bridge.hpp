@@ -0,0 +1,19 @@
+#pragma once
+
+#include <avr/io.hpp>
+#include <avr/uart/bridge.hpp>
+
+using namespace avr::uart::literals;
+
+template<uint32_t clk, uint32_t src_baud_rate, uint32_t dst_baud_rate>
+inline void test_for(uint8_t osccal_p) {
+  using namespace avr::io;
+  
+  osccal = osccal_p;
+  
+  avr::uart::bridge<avr::uart::soft<Pb0/*tx*/, Pb1/*rx*/, src_baud_rate, clk>,
+                    avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, dst_baud_rate, clk>> b;
+  
+  while(true)
+    b.forward(48);
+}
@@ -0,0 +1,4 @@
+#include "bridge.hpp"
+
+int main()
+{ test_for<8_MHz, 57600_bps, 1_Mbps>(0x9a); }
@@ -6,7 +6,9 @@
 
 ./make-t85.sh -j8 -B \
     repeater_8Mhz_1Mbps.s \
+    bridge_8Mhz_57600bps_1Mbps.s \
     tx_8Mhz_1Mbps.s \
+    tx_rx_unrolled_8Mhz_1600kbps.s \
     tx_rx_8Mhz_576kbps.s \
     tx_rx_8Mhz_500kbps.s \
     tx_rx_8Mhz_460800bps.s \
@@ -15,4 +17,32 @@
     tx_rx_1Mhz_57600bps.s \
     tx_rx_1Mhz_38400bps.s \
     tx_rx_1Mhz_19200bps.s \
-    tx_rx_1Mhz_9600bps
+    tx_rx_1Mhz_9600bps.s \
+    sleep_rx_1Mhz_9600bps.s \
+    sleep_rx_seq_1Mhz_9600bps.s \
+    cut_through_1Mhz_9600bps.s \
+    dmx_8Mhz_250kbps.s \
+    modbus_8Mhz_115200bps.s \
+    rx_checked_8Mhz_115200bps.s \
+    multidrop_8Mhz_115200bps.s \
+    compress_1Mhz_9600bps.s \
+    select_8Mhz_115200bps.s \
+    event_loop_8Mhz_57600bps.s \
+    timestamp_8Mhz_115200bps.s \
+    eye_scan_8Mhz_115200bps.s \
+    ir_8Mhz_2400bps.s \
+    manchester_8Mhz_115200bps.s \
+    transfer_8Mhz_57600bps.s \
+    usi_8Mhz_115200bps.s
+
+./make-m2560.sh -j8 -B \
+    ext_io_16Mhz_1Mbps.s
+
+./make-t1614.sh -j8 -B \
+    vport_20Mhz_2500kbps.s
+
+make -C ../bootloader -B all
+
+./make-t13a.sh check-timing || exit 1
+./make-t85.sh check-timing || exit 1
+./make-m2560.sh check-timing || exit 1
@@ -0,0 +1,28 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/uart/compress.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9d;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 9600_bps, 1_MHz> uart;
+  compressed_tx tx{uart};
+
+  /** A slow triangle wave with plateaus. The samples can be checked by
+      helper/decompress. */
+  uint16_t sample{0};
+  int8_t step{1};
+  while(true) {
+    for(uint8_t i{0}; i < 64; ++i) {
+      if((i & 0x0f) < 12) sample += step;
+      tx.put(sample);
+    }
+    tx.flush();
+    if(sample >= 1000 || sample == 0) step = -step;
+  }
+}
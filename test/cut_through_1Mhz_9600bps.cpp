@@ -0,0 +1,19 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  
+  osccal = 0x9d;
+
+  avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 9600_bps, 1_MHz> uart;
+
+  /** The first byte of each frame of 4 bytes is a hop counter. */
+  while(true) {
+    uart.repeat(true);
+    for(uint8_t i{0}; i < 3; ++i)
+      uart.repeat();
+  }
+}
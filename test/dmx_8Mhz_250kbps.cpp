@@ -0,0 +1,22 @@
+#include <avr/io.hpp>
+#include <avr/uart/dmx.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+
+  osccal = 0x9a;
+
+  using uart_t = avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 250_kbps, 8_MHz>;
+  avr::uart::dmx_receiver<uart_t, 3> fixture{10};
+  uart_t uart;
+
+  /** The slots 10, 11 and 12 of each packet are transmitted after the
+   * packet with a break before them. */
+  while(true) {
+    auto n = fixture.receive();
+    uart.send_break();
+    for(uint16_t i{0}; i < n; ++i) uart.put(fixture[i]);
+  }
+}
@@ -0,0 +1,55 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/uart/event_loop.hpp>
+#include <avr/interrupt.h>
+
+using namespace avr::uart::literals;
+
+volatile bool pressed{false};
+
+/** 17 cycles: the response and the 'rjmp' of the vector(6), the body
+    without SREG because 'ldi' and 'sts' don't change it(7) and
+    'reti'(4). An ISR written in C takes about 32 cycles, which is
+    more than the tolerance of 34 cycles minus the longest handler. */
+ISR(PCINT0_vect, ISR_NAKED) {
+  asm volatile(
+    "push r24\n\t"
+    "ldi r24, 1\n\t"
+    "sts %0, r24\n\t"
+    "pop r24\n\t"
+    "reti\n\t"
+    :: "i"(&pressed));
+}
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 57600_bps, 8_MHz> a;
+  soft<Pb4/*tx*/, Pb2/*rx*/, 57600_bps, 8_MHz> b;
+
+  /** button at Pb0 */
+  GIMSK |= _BV(PCIE);
+  PCMSK = _BV(PCINT0);
+  sei();
+
+  /** The bytes of a are summed, the bytes of b are counted, and both
+      are transmitted when the button is pressed. The transmission
+      takes much longer than a quarter of a bit, so it's done out of
+      the handlers by poll(). */
+  uint8_t sum{0}, count{0};
+  bool report{false};
+  event_loop loop{
+    on_byte<2>(a, [&](uint8_t byte){ sum += byte; }),
+    on_byte<2>(b, [&](uint8_t){ ++count; }),
+    on_flag<2, 17>(pressed, [&]{ report = true; })};
+  static_assert(decltype(loop)::no_missed_start_bit);
+  while(true) {
+    if(loop.poll() || !report) continue;
+    report = false;
+    a.put(sum);
+    a.put(count);
+  }
+}
@@ -0,0 +1,34 @@
+#include <avr/io.h>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+/** Pin of the port H of the ATmega2560, which is only reachable by
+    'lds' and 'sts'. The I/O addresses of PINH, DDRH and PORTH are
+    0xe0, 0xe1 and 0xe2. */
+template<uint8_t Bit>
+struct ph {
+  struct ddrx { static constexpr uint8_t io_addr() { return 0xe1; } };
+  struct portx { static constexpr uint8_t io_addr() { return 0xe2; } };
+  struct pinx { static constexpr uint8_t io_addr() { return 0xe0; } };
+
+  static constexpr uint8_t value{Bit};
+  static constexpr uint8_t bv() { return 1 << Bit; }
+
+  static void out() { DDRH |= bv(); }
+  static void in() { DDRH &= ~bv(); }
+  static void high() { PORTH |= bv(); }
+  static void low() { PORTH &= ~bv(); }
+  static bool is_high() { return PINH & bv(); }
+  static bool is_low() { return !is_high(); }
+};
+
+using uart_t = avr::uart::soft<ph<1>/*tx*/, ph<0>/*rx*/, 1_Mbps, 16_MHz>;
+static_assert(uart_t::tx_extended_io && uart_t::rx_extended_io);
+
+int main() {
+  uart_t uart;
+
+  while(true)
+    uart.put(uart.get());
+}
@@ -0,0 +1,22 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> uart;
+
+  /** The peer sends 0x55 with gaps of 2 frames until it receives the
+      window, and the bytes after it are echoed sampling them at 60%
+      of the bit. */
+  auto eye = uart.eye_scan(0x55);
+  uart.put(eye.open);
+  uart.put(eye.from);
+  uart.put(eye.to);
+  while(true) uart.put(uart.get<60>());
+}
@@ -0,0 +1,58 @@
+/**
+   Host run of an echo application using the host backend. The bytes
+   transmitted by the application are decoded from the Tx pin and
+   compared with the received ones, and the waveform is written to
+   host_echo.vcd.
+ */
+#include <avr/uart/host.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace avr::uart;
+
+using tx = host::pin<'t'>;
+using rx = host::pin<'r'>;
+
+using uart_t = host::soft<tx, rx, 115200_bps, 8_MHz>;
+
+/** application logic under test */
+template<typename Uart>
+void echo(const Uart& uart) {
+  while(true) {
+    auto byte = uart.get();
+    host::delay_cycles(40); //processing of the byte
+    uart.put(byte);
+  }
+}
+
+int main() {
+  const char msg[]{"hello"};
+  uint64_t at{1000};
+  for(auto c : msg) at = host::transmit<rx>(at, c, uart_t::bit_length, 12);
+
+  uart_t uart;
+  try { echo(uart); } catch(host::end_of_input) {}
+
+  /** decode the Tx pin sampling the middle of each bit */
+  uint64_t t{0};
+  for(auto c : msg) {
+    uint64_t start;
+    if(!tx::next_edge(t, false, start)) {
+      std::printf("missing byte\n");
+      return EXIT_FAILURE;
+    }
+    if(c == msg[0]) std::printf("turnaround: %llu cycles\n",
+      (unsigned long long)(start - (1000 + 9 * uart_t::bit_length)));
+    uint8_t byte{0};
+    for(uint8_t i{0}; i < 8; ++i)
+      byte |= tx::level(start + (i + 1.5) * uart_t::bit_length) << i;
+    if(byte != uint8_t(c)) {
+      std::printf("expected %#04x, got %#04x\n", c, byte);
+      return EXIT_FAILURE;
+    }
+    t = start + 10 * uart_t::bit_length;
+  }
+  host::save_vcd("host_echo.vcd", uart_t::clk);
+  std::printf("ok\n");
+}
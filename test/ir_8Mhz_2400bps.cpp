@@ -0,0 +1,16 @@
+#include <avr/io.hpp>
+#include <avr/uart/ir.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  /** IR LED at Pb4 and the output of a 38 kHz TSOP receiver at Pb3. */
+  ir<Pb4/*tx*/, Pb3/*rx*/, 2400_bps, 38_kHz, 8_MHz> link;
+
+  while(true) link.put(link.get());
+}
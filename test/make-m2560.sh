@@ -0,0 +1,2 @@
+#!/bin/sh
+make MCU=atmega2560 DEV=m2560 $@
@@ -0,0 +1,2 @@
+#!/bin/sh
+make MCU=attiny1614 DEV=t1614 $@
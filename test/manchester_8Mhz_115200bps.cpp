@@ -0,0 +1,23 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/uart/manchester.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  /** OSCCAL isn't calibrated: the bursts tolerate about ±20% at 69
+      cycles per bit. */
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> uart;
+
+  static_assert(manchester_tolerance<decltype(uart)>() > 0.19);
+
+  /** Each burst of 16 bytes is echoed back as a burst. */
+  uint8_t frame[16];
+  while(true) {
+    get_manchester(uart, frame, sizeof(frame));
+    put_manchester(uart, frame, sizeof(frame));
+  }
+}
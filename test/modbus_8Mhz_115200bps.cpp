@@ -0,0 +1,19 @@
+#include <avr/io.hpp>
+#include <avr/uart/modbus.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+
+  osccal = 0x9a;
+
+  /** The register 0 counts the executed requests. */
+  uint16_t regs[16]{};
+  avr::uart::modbus_slave<
+    avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz>> slave{
+    0x11, regs, 16};
+
+  while(true)
+    if(slave.poll()) ++regs[0];
+}
@@ -0,0 +1,27 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/interrupt.h>
+
+using namespace avr::uart::literals;
+
+EMPTY_INTERRUPT(PCINT0_vect);
+EMPTY_INTERRUPT(TIM0_COMPA_vect);
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> uart;
+
+  /** The node 0x12 answers each request of 2 bytes to the master with
+      their sum. Each address on the bus is followed by 2 data bytes,
+      which are skipped by Timer/Counter0 when they are addressed to
+      other nodes. */
+  while(true) {
+    auto req = uart.sleep_get_addressed<2, sleep_mode::idle, 2>(0x12);
+    uart.put9(0x00, true);
+    uart.put9(req[0] + req[1], false);
+  }
+}
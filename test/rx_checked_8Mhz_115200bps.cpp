@@ -0,0 +1,28 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/uart/format.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> uart;
+  link_stats stats;
+
+  /** The counters are transmitted after each sequence of 16 bytes. */
+  while(true) {
+    uart.get_bytes<16>(stats);
+    put_dec(uart, stats.bytes);
+    uart.put(' ');
+    put_dec(uart, stats.framing_errors);
+    uart.put(' ');
+    put_dec(uart, stats.glitches);
+    uart.put(' ');
+    put_dec(uart, stats.overruns);
+    uart.put('\n');
+  }
+}
@@ -0,0 +1,24 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/uart/select.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> a;
+  soft<Pb4/*tx*/, Pb2/*rx*/, 115200_bps, 8_MHz> b;
+  soft<Pb4/*tx*/, Pb1/*rx*/, 115200_bps, 8_MHz> c;
+
+  /** Each byte received on any of the three Rx pins is echoed to Tx
+      after the index of its channel as a digit. */
+  while(true) {
+    auto [channel, byte] = select(a, b, c);
+    a.put('0' + channel);
+    a.put(byte);
+  }
+}
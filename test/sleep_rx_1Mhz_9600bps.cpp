@@ -0,0 +1,18 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/interrupt.h>
+
+using namespace avr::uart::literals;
+
+EMPTY_INTERRUPT(PCINT0_vect);
+
+int main() {
+  using namespace avr::io;
+  
+  osccal = 0x9d;
+
+  avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 9600_bps, 1_MHz> uart;
+
+  while(true)
+    uart.put(uart.sleep_get());
+}
@@ -0,0 +1,24 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+#include <avr/interrupt.h>
+
+using namespace avr::uart::literals;
+
+EMPTY_INTERRUPT(PCINT0_vect);
+
+int main() {
+  using namespace avr::io;
+  
+  osccal = 0x9d;
+
+  using uart_t = avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 9600_bps, 1_MHz>;
+  static_assert(uart_t::sleep_between_bytes<avr::uart::sleep_mode::idle>);
+  uart_t uart;
+
+  /** The MCU sleeps in the idle mode between the 4 bytes of each
+      sequence, and the sequence is echoed. */
+  while(true) {
+    auto bytes = uart.sleep_get_bytes<4>();
+    for(auto b : bytes) uart.put(b);
+  }
+}
@@ -0,0 +1,27 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 115200_bps, 8_MHz> uart;
+
+  /** Timer0 running at clk/8, 1 us per tick. */
+  using tcnt0 = timer_counter<0x32>;
+  TCCR0A = 0;
+  TCCR0B = _BV(CS01);
+
+  /** Each block of 4 bytes is answered with the idle gaps in
+      microseconds between its bytes. */
+  while(true) {
+    timestamped v[4];
+    uart.get_timestamped<tcnt0>(v, 4);
+    for(uint8_t i{1}; i < 4; ++i)
+      uart.put(v[i].time - v[i - 1].time - uart.frame_ticks(8));
+  }
+}
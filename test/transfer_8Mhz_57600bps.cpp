@@ -0,0 +1,22 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+  using namespace avr::uart;
+
+  osccal = 0x9a;
+
+  soft<Pb4/*tx*/, Pb3/*rx*/, 57600_bps, 8_MHz> uart;
+
+  /** A counter is transmitted while the peer sends its own bytes, and
+      the next request carries the XOR of the last reply. */
+  uint8_t cnt{0}, last{0};
+  while(true) {
+    const uint8_t req[]{cnt++, last};
+    auto res = uart.transfer_bytes<2>(req);
+    last = res[0] ^ res[1];
+  }
+}
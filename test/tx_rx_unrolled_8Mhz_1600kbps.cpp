@@ -0,0 +1,15 @@
+#include <avr/io.hpp>
+#include <avr/uart.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::io;
+
+  osccal = 0x9a;
+
+  avr::uart::soft<Pb4/*tx*/, Pb3/*rx*/, 1600_kbps, 8_MHz> uart;
+
+  while(true)
+    uart.put_unrolled(uart.get_unrolled());
+}
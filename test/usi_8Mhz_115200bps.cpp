@@ -0,0 +1,22 @@
+#include <avr/io.hpp>
+#include <avr/uart/usi.hpp>
+
+using namespace avr::uart::literals;
+
+using uart_t = avr::uart::usi<115200_bps, 8_MHz>;
+
+AVR_UART_USI_ISR(uart_t);
+
+int main() {
+  avr::io::osccal = 0x9a;
+
+  uart_t uart;
+  sei();
+  uart.listen();
+
+  while(true) {
+    auto bytes = uart.get_bytes<4>();
+    for(auto b : bytes)
+      uart.put(b);
+  }
+}
@@ -0,0 +1,17 @@
+#include <avr/io.h>
+#include <avr/uart.hpp>
+#include <avr/uart/vport.hpp>
+
+using namespace avr::uart::literals;
+
+int main() {
+  using namespace avr::uart;
+
+  /** 20 MHz without the prescaler of the main clock */
+  _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, 0);
+
+  soft<vport::pa<6>/*tx*/, vport::pa<7>/*rx*/, 2500_kbps, 20_MHz> uart;
+
+  while(true)
+    uart.put(uart.get());
+}